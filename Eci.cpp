@@ -23,30 +23,24 @@ namespace SGP4 {
 
 /**
  * Converts a DateTime and Geodetic position to Eci coordinates
- * @param[in] dt the date
+ * @param[in] orientation the earth orientation at the date
  * @param[in] geo the geodetic position
  */
-void Eci::ToEci( const DateTime& dt, const CoordGeodetic &geo )
+void Eci::ToEci( const EarthOrientation& orientation, const CoordGeodetic &geo )
 {
     /*
      * set date
      */
-    m_dt = dt;
-
-    static const double mfactor = kTWOPI * ( kOMEGA_E / kSECONDS_PER_DAY );
+    m_dt = orientation.GetDateTime();
 
     /*
      * Calculate Local Mean Sidereal Time for observers longitude
      */
-    const double theta = m_dt.ToLocalMeanSiderealTime( geo.longitude );
+    const double theta = orientation.LocalMeanSiderealTime( geo.longitude );
 
-    /*
-     * take into account earth flattening
-     */
-    const double c = 1.0
-        / sqrt( 1.0 + kF * ( kF - 2.0 ) * pow( sin( geo.latitude ), 2.0 ) );
-    const double s = pow( 1.0 - kF, 2.0 ) * c;
-    const double achcp = ( kXKMPER * c + geo.altitude ) * cos( geo.latitude );
+    double achcp;
+    double z;
+    EarthFixedDistances( geo, achcp, z );
 
     /*
      * X position in km
@@ -56,7 +50,7 @@ void Eci::ToEci( const DateTime& dt, const CoordGeodetic &geo )
      */
     m_position.x = achcp * cos( theta );
     m_position.y = achcp * sin( theta );
-    m_position.z = ( kXKMPER * s + geo.altitude ) * sin( geo.latitude );
+    m_position.z = z;
     m_position.w = m_position.Magnitude();
 
     /*
@@ -65,21 +59,116 @@ void Eci::ToEci( const DateTime& dt, const CoordGeodetic &geo )
      * Z velocity in km/s
      * W magnitude in km/s
      */
-    m_velocity.x = -mfactor * m_position.y;
-    m_velocity.y = mfactor * m_position.x;
+    m_velocity.x = -kEARTH_ROTATION * m_position.y;
+    m_velocity.y = kEARTH_ROTATION * m_position.x;
     m_velocity.z = 0.0;
     m_velocity.w = m_velocity.Magnitude();
 }
 
+void Eci::EarthFixedDistances( const CoordGeodetic& geo,
+                               double& axis_distance,
+                               double& equator_distance )
+{
+    const double sin_lat = sin( geo.latitude );
+    const double c = 1.0 / sqrt( 1.0 + kF * ( kF - 2.0 ) * sin_lat * sin_lat );
+    const double s = ( 1.0 - kF ) * ( 1.0 - kF ) * c;
+    axis_distance = ( kXKMPER * c + geo.altitude ) * cos( geo.latitude );
+    equator_distance = ( kXKMPER * s + geo.altitude ) * sin_lat;
+}
+
+namespace {
+/*
+ * Bowring's method from the parametric latitude of his 1985 starting
+ * point, tan u = ( b z / a p ) ( 1 + e'^2 b / r ), in homogeneous form so
+ * the poles need no special case. sin and cos of the latitude come from
+ * the terms of its tangent, for the altitude without trigonometry
+ */
+inline void BowringGeodetic( const double x,
+                             const double y,
+                             const double z,
+                             const double gmst,
+                             double& lat,
+                             double& lon,
+                             double& alt )
+{
+    static const double a = kXKMPER;
+    static const double b = kXKMPER * ( 1.0 - kF );
+    static const double e2 = kF * ( 2.0 - kF );
+    static const double ep2 = e2 / ( 1.0 - e2 );
+
+    const double p = sqrt( x * x + y * y );
+    const double r = sqrt( p * p + z * z );
+
+    const double sin_u = b * z * ( r + ep2 * b );
+    const double cos_u = a * p * r;
+    const double u_norm = 1.0 / sqrt( sin_u * sin_u + cos_u * cos_u );
+    const double su = sin_u * u_norm;
+    const double cu = cos_u * u_norm;
+
+    const double num = z + ep2 * b * su * su * su;
+    const double den = p - e2 * a * cu * cu * cu;
+    const double norm = 1.0 / sqrt( num * num + den * den );
+    const double sin_lat = num * norm;
+    const double cos_lat = den * norm;
+
+    lat = atan2( num, den );
+    lon = Util::WrapNegPosPI( atan2( y, x ) - gmst );
+    alt = p * cos_lat + z * sin_lat - a * sqrt( 1.0 - e2 * sin_lat * sin_lat );
+}
+}
+
 /**
+ * @param[in] method how to solve for the latitude
  * @returns the position in geodetic form
  */
-CoordGeodetic Eci::ToGeodetic() const
+CoordGeodetic Eci::ToGeodetic( const GeodeticMethod method ) const
 {
+    return ToGeodetic( m_dt.ToGreenwichSiderealTime(), method );
+}
+
+void Eci::ToGeodetic( const EarthOrientation& orientation,
+                      const Vector* positions,
+                      const size_t count,
+                      CoordGeodetic* geodetic,
+                      const GeodeticMethod method )
+{
+    const double gmst = orientation.Gmst();
+
+    if ( method == GeodeticMethod::Iterative )
+    {
+        for ( size_t i = 0; i < count; i++ )
+        {
+            geodetic[i] = Eci( orientation.GetDateTime(), positions[i] ).ToGeodetic( gmst, method );
+        }
+        return;
+    }
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        BowringGeodetic( positions[i].x, positions[i].y, positions[i].z, gmst,
+                geodetic[i].latitude, geodetic[i].longitude, geodetic[i].altitude );
+    }
+}
+
+/**
+ * @param[in] gmst the greenwich mean sidereal time of this position
+ * @param[in] method how to solve for the latitude
+ * @returns the position in geodetic form
+ */
+CoordGeodetic Eci::ToGeodetic( const double gmst, const GeodeticMethod method ) const
+{
+    if ( method == GeodeticMethod::Bowring )
+    {
+        double lat;
+        double lon;
+        double alt;
+        BowringGeodetic( m_position.x, m_position.y, m_position.z, gmst, lat, lon, alt );
+        return CoordGeodetic( lat, lon, alt, true );
+    }
+
     const double theta = Util::AcTan( m_position.y, m_position.x );
 
-    const double lon = Util::WrapNegPosPI( theta
-                                           - m_dt.ToGreenwichSiderealTime() );
+    const double lon = Util::WrapNegPosPI( theta - gmst );
 
     const double r = sqrt( ( m_position.x * m_position.x )
                            + ( m_position.y * m_position.y ) );
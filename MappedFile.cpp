@@ -0,0 +1,103 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/MappedFile.h>
+#include <SGP4/TleException.h>
+
+#if defined( _WIN32 )
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SGP4 {
+
+MappedFile::MappedFile()
+    : m_data( nullptr )
+    , m_size( 0 )
+    , m_mapping( nullptr )
+{
+}
+
+MappedFile::MappedFile( const std::string& filename, const bool sequential )
+    : m_data( nullptr )
+    , m_size( 0 )
+    , m_mapping( nullptr )
+{
+#if defined( _WIN32 )
+    std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+    if ( !file )
+    {
+        throw TleException( "Failed to open file" );
+    }
+
+    m_buffer.assign( std::istreambuf_iterator< char >( file ),
+                     std::istreambuf_iterator< char >() );
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    ( void )sequential;
+#else
+    const int fd = open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        throw TleException( "Failed to open file" );
+    }
+
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 )
+    {
+        close( fd );
+        throw TleException( "Failed to open file" );
+    }
+
+    m_size = static_cast< size_t >( st.st_size );
+    if ( m_size > 0 )
+    {
+        void* mapping = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( mapping == MAP_FAILED )
+        {
+            close( fd );
+            throw TleException( "Failed to map file" );
+        }
+
+        if ( sequential )
+        {
+            madvise( mapping, m_size, MADV_SEQUENTIAL );
+        }
+
+        m_mapping = mapping;
+        m_data = static_cast< const char* >( mapping );
+    }
+    close( fd );
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined( _WIN32 )
+    if ( m_mapping )
+    {
+        munmap( m_mapping, m_size );
+    }
+#endif
+}
+
+} //namespace SGP4
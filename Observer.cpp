@@ -17,44 +17,94 @@
 
 #include <SGP4/Observer.h>
 #include <SGP4/CoordTopocentric.h>
+#include <SGP4/Globals.h>
+
+#include <algorithm>
 
 namespace SGP4 {
 
+namespace {
+/*
+ * samples whose sidereal angles GetLookAngles advances by rotation from one
+ * evaluation, bounding the rounding the recurrence accumulates
+ */
+static const size_t kLookAngleBlock = 64;
+
+/*
+ * the rate of the greenwich mean sidereal time in radians per day, the
+ * derivative of the polynomial in DateTime::ToGreenwichSiderealTime
+ */
+double SiderealRate( const DateTime& dt )
+{
+    const double t = ( dt.ToJulian() - 2451545.0 ) / 36525.0;
+    const double rate = ( 876600.0 * 3600.0 + 8640184.812866 )
+        + 2.0 * 0.093104 * t
+        - 3.0 * 0.0000062 * t * t;
+    return Util::DegreesToRadians( rate / 240.0 ) / 36525.0;
+}
+}
+
+/*
+ * precompute the parts of the observers position that do not depend on time
+ */
+void Observer::Initialise()
+{
+    m_sin_lat = sin( m_geo.latitude );
+    m_cos_lat = cos( m_geo.latitude );
+    m_sin_lon = sin( m_geo.longitude );
+    m_cos_lon = cos( m_geo.longitude );
+
+    Eci::EarthFixedDistances( m_geo, m_axis_distance, m_equator_distance );
+}
+
 /*
  * calculate lookangle between the observer and the passed in Eci object
  */
-CoordTopocentric Observer::GetLookAngle( const Eci &eci )
+CoordTopocentric Observer::GetLookAngle( const Eci &eci ) const
+{
+    return GetLookAngle( eci, EarthOrientation( eci.GetDateTime() ) );
+}
+
+/*
+ * calculate lookangle between the observer and the passed in Eci object,
+ * with the earth orientation at the date of the Eci object
+ */
+CoordTopocentric Observer::GetLookAngle( const Eci &eci,
+                                         const EarthOrientation& orientation ) const
 {
     /*
-     * update the observers Eci to match the time of the Eci passed in
-     * if necessary
+     * Local Mean Sidereal Time for observers longitude, as the sum of the
+     * greenwich sidereal time and the longitude
      */
-    Update( eci.GetDateTime() );
+    const double sin_theta = orientation.SinGmst() * m_cos_lon
+        + orientation.CosGmst() * m_sin_lon;
+    const double cos_theta = orientation.CosGmst() * m_cos_lon
+        - orientation.SinGmst() * m_sin_lon;
 
     /*
-     * calculate differences
+     * the observers position and velocity at the time of the Eci passed in
      */
-    Vector range_rate = eci.Velocity() - m_eci.Velocity();
-    Vector range = eci.Position() - m_eci.Position();
-
-    range.w = range.Magnitude();
+    const Vector position( m_axis_distance * cos_theta,
+                           m_axis_distance * sin_theta,
+                           m_equator_distance );
+    const Vector velocity( -kEARTH_ROTATION * position.y,
+                           kEARTH_ROTATION * position.x,
+                           0.0 );
 
     /*
-     * Calculate Local Mean Sidereal Time for observers longitude
+     * calculate differences
      */
-    double theta = eci.GetDateTime().ToLocalMeanSiderealTime( m_geo.longitude );
+    Vector range_rate = eci.Velocity() - velocity;
+    Vector range = eci.Position() - position;
 
-    double sin_lat = sin( m_geo.latitude );
-    double cos_lat = cos( m_geo.latitude );
-    double sin_theta = sin( theta );
-    double cos_theta = cos( theta );
+    range.w = range.Magnitude();
 
-    double top_s = sin_lat * cos_theta * range.x
-        + sin_lat * sin_theta * range.y - cos_lat * range.z;
+    double top_s = m_sin_lat * cos_theta * range.x
+        + m_sin_lat * sin_theta * range.y - m_cos_lat * range.z;
     double top_e = -sin_theta * range.x
         + cos_theta * range.y;
-    double top_z = cos_lat * cos_theta * range.x
-        + cos_lat * sin_theta * range.y + sin_lat * range.z;
+    double top_z = m_cos_lat * cos_theta * range.x
+        + m_cos_lat * sin_theta * range.y + m_sin_lat * range.z;
     double az = atan( -top_e / top_s );
 
     if ( top_s > 0.0 )
@@ -82,4 +132,126 @@ CoordTopocentric Observer::GetLookAngle( const Eci &eci )
                              rate );
 }
 
+/*
+ * calculate lookangles between the observer and each passed in Eci object
+ */
+void Observer::GetLookAngles( const Eci* ecis,
+                              const size_t count,
+                              CoordTopocentric* look_angles ) const
+{
+    double sin_theta[kLookAngleBlock];
+    double cos_theta[kLookAngleBlock];
+    double rx[kLookAngleBlock];
+    double ry[kLookAngleBlock];
+    double rz[kLookAngleBlock];
+    double vx[kLookAngleBlock];
+    double vy[kLookAngleBlock];
+    double vz[kLookAngleBlock];
+    double azimuth[kLookAngleBlock];
+    double elevation[kLookAngleBlock];
+    double range[kLookAngleBlock];
+    double rate[kLookAngleBlock];
+
+    for ( size_t start = 0; start < count; start += kLookAngleBlock )
+    {
+        const size_t n = std::min( kLookAngleBlock, count - start );
+        const Eci* block = ecis + start;
+
+        /*
+         * Local Mean Sidereal Time of the first sample, as GetLookAngle
+         * finds it
+         */
+        const EarthOrientation first( block[0].GetDateTime() );
+        sin_theta[0] = first.SinGmst() * m_cos_lon + first.CosGmst() * m_sin_lon;
+        cos_theta[0] = first.CosGmst() * m_cos_lon - first.SinGmst() * m_sin_lon;
+
+        const int64_t step = n > 1
+            ? block[1].GetDateTime().Ticks() - block[0].GetDateTime().Ticks()
+            : 0;
+        bool uniform = true;
+        for ( size_t k = 2; k < n && uniform; k++ )
+        {
+            uniform = block[k].GetDateTime().Ticks()
+                - block[k - 1].GetDateTime().Ticks() == step;
+        }
+
+        if ( uniform )
+        {
+            /*
+             * the angle turned through in one step, at the sidereal rate of
+             * the middle of the block
+             */
+            const DateTime middle( block[0].GetDateTime().Ticks()
+                    + step * static_cast< int64_t >( n - 1 ) / 2 );
+            const double delta = SiderealRate( middle )
+                * static_cast< double >( step ) / TicksPerDay;
+            const double sin_delta = sin( delta );
+            const double cos_delta = cos( delta );
+            for ( size_t k = 1; k < n; k++ )
+            {
+                sin_theta[k] = sin_theta[k - 1] * cos_delta + cos_theta[k - 1] * sin_delta;
+                cos_theta[k] = cos_theta[k - 1] * cos_delta - sin_theta[k - 1] * sin_delta;
+            }
+        }
+        else
+        {
+            for ( size_t k = 1; k < n; k++ )
+            {
+                const EarthOrientation orientation( block[k].GetDateTime() );
+                sin_theta[k] = orientation.SinGmst() * m_cos_lon
+                    + orientation.CosGmst() * m_sin_lon;
+                cos_theta[k] = orientation.CosGmst() * m_cos_lon
+                    - orientation.SinGmst() * m_sin_lon;
+            }
+        }
+
+        /*
+         * the range from the observer and its rate of change, gathered into
+         * arrays so the transform runs over contiguous values
+         */
+        for ( size_t k = 0; k < n; k++ )
+        {
+            const Vector position = block[k].Position();
+            const Vector velocity = block[k].Velocity();
+            const double site_x = m_axis_distance * cos_theta[k];
+            const double site_y = m_axis_distance * sin_theta[k];
+
+            rx[k] = position.x - site_x;
+            ry[k] = position.y - site_y;
+            rz[k] = position.z - m_equator_distance;
+            vx[k] = velocity.x + kEARTH_ROTATION * site_y;
+            vy[k] = velocity.y - kEARTH_ROTATION * site_x;
+            vz[k] = velocity.z;
+        }
+
+        /*
+         * the topocentric transform of GetLookAngle, with the azimuth from
+         * atan2 so the loop has no branches
+         */
+        for ( size_t k = 0; k < n; k++ )
+        {
+            const double top_s = m_sin_lat * cos_theta[k] * rx[k]
+                + m_sin_lat * sin_theta[k] * ry[k] - m_cos_lat * rz[k];
+            const double top_e = -sin_theta[k] * rx[k]
+                + cos_theta[k] * ry[k];
+            const double top_z = m_cos_lat * cos_theta[k] * rx[k]
+                + m_cos_lat * sin_theta[k] * ry[k] + m_sin_lat * rz[k];
+
+            const double az = atan2( top_e, -top_s );
+            range[k] = sqrt( rx[k] * rx[k] + ry[k] * ry[k] + rz[k] * rz[k] );
+            azimuth[k] = az < 0.0 ? az + kTWOPI : az;
+            elevation[k] = asin( top_z / range[k] );
+            rate[k] = ( rx[k] * vx[k] + ry[k] * vy[k] + rz[k] * vz[k] ) / range[k];
+        }
+
+        for ( size_t k = 0; k < n; k++ )
+        {
+            look_angles[start + k] = CoordTopocentric( azimuth[k],
+                                                       elevation[k],
+                                                       range[k],
+                                                       rate[k] );
+        }
+    }
+}
+
 } //namespace SGP4
@@ -17,6 +17,7 @@
 
 #include <SGP4/OrbitalElements.h>
 #include <SGP4/Tle.h>
+#include <SGP4/TleRecord.h>
 
 namespace SGP4 {
 
@@ -34,6 +35,28 @@ OrbitalElements::OrbitalElements( const Tle& tle )
     bstar_ = tle.BStar();
     epoch_ = tle.Epoch();
 
+    Initialise();
+}
+
+OrbitalElements::OrbitalElements( const TleRecord& record )
+{
+    /*
+     * same conversions as Tle
+     */
+    mean_anomoly_ = Util::DegreesToRadians( record.mean_anomaly );
+    ascending_node_ = Util::DegreesToRadians( record.right_ascending_node );
+    argument_perigee_ = Util::DegreesToRadians( record.argument_perigee );
+    eccentricity_ = record.eccentricity;
+    inclination_ = Util::DegreesToRadians( record.inclination );
+    mean_motion_ = record.mean_motion * kTWOPI / kMINUTES_PER_DAY;
+    bstar_ = record.bstar;
+    epoch_ = record.epoch;
+
+    Initialise();
+}
+
+void OrbitalElements::Initialise()
+{
     /*
      * recover original mean motion (xnodp) and semimajor axis (aodp)
      * from input elements
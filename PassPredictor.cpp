@@ -0,0 +1,278 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/PassPredictor.h>
+#include <SGP4/Globals.h>
+#include <SGP4/Util.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SGP4 {
+
+namespace {
+/*
+ * allowance for the spherical earth of the coarse search against the
+ * geodetic elevation of the look angle
+ */
+static const double kCapMargin = Util::DegreesToRadians( 1.0 );
+/*
+ * the step near the observer only assumes half the current angular rate
+ */
+static const double kRateSafety = 0.5;
+static const double kMinStep = 1.0;
+static const double kCrossingTolerance = 1.0e-3;
+static const double kMaxElevationTolerance = 0.1;
+
+/*
+ * a satellite and observer sampled at a time, seconds from the start
+ */
+struct Sample
+{
+    double seconds;
+    Eci eci;
+    CoordTopocentric look;
+    /*
+     * elevation above the minimum, in radians
+     */
+    double margin;
+};
+
+class Search
+{
+public:
+    Search( const SGP4& sgp4,
+            const Observer& observer,
+            const DateTime& start,
+            const double min_elevation )
+        : sgp4_( sgp4 )
+        , observer_( observer )
+        , start_( start )
+        , min_elevation_( min_elevation )
+        , observer_radius_( Eci( start, observer.GetLocation() ).Position().Magnitude() )
+    {
+        const OrbitalElements& elements = sgp4.Elements();
+        const double e = elements.Eccentricity();
+        const double n = elements.RecoveredMeanMotion() / 60.0;
+
+        /*
+         * the largest angle between observer and satellite, seen from the
+         * centre of the earth, at which the satellite can be in view
+         */
+        const double apogee = elements.RecoveredSemiMajorAxis() * ( 1.0 + e ) * kXKMPER;
+        const double cos_cap = std::min( 1.0, observer_radius_ * cos( min_elevation ) / apogee );
+        cap_ = acos( cos_cap ) - min_elevation + kCapMargin;
+
+        /*
+         * the fastest the satellite moves across the sky at perigee, plus
+         * the rotation of the observer
+         */
+        max_orbit_rate_ = n * ( 1.0 + e ) * ( 1.0 + e ) / pow( 1.0 - e * e, 1.5 )
+            + kEARTH_ROTATION;
+        max_step_ = elements.Period() * 60.0 / 8.0;
+    }
+
+    Sample At( const double seconds )
+    {
+        Sample sample;
+        sample.seconds = seconds;
+        sample.eci = sgp4_.FindPosition( context_, TimeAt( seconds ) );
+        sample.look = observer_.GetLookAngle( sample.eci );
+        sample.margin = sample.look.elevation - min_elevation_;
+        return sample;
+    }
+
+    DateTime TimeAt( const double seconds ) const
+    {
+        return start_.AddTicks( static_cast< int64_t >( llround( seconds * TicksPerSecond ) ) );
+    }
+
+    /*
+     * a step no pass can start or end within
+     */
+    double Step( const Sample& sample ) const
+    {
+        const double r = sample.eci.Position().Magnitude();
+        const double rho = sample.look.range;
+        const double cos_angle = ( observer_radius_ * observer_radius_ + r * r - rho * rho )
+            / ( 2.0 * observer_radius_ * r );
+        const double angle = acos( std::max( -1.0, std::min( 1.0, cos_angle ) ) );
+
+        double step;
+        if ( angle > cap_ )
+        {
+            step = ( angle - cap_ ) / max_orbit_rate_;
+        }
+        else
+        {
+            /*
+             * the direction to the satellite turns no faster than the
+             * relative velocity over the range
+             */
+            const double speed = sample.eci.Velocity().Magnitude()
+                + kEARTH_ROTATION * observer_radius_;
+            step = kRateSafety * fabs( sample.margin ) * rho / speed;
+        }
+
+        return std::max( kMinStep, std::min( step, max_step_ ) );
+    }
+
+    /*
+     * the crossing of the minimum elevation between two samples
+     */
+    Sample Crossing( const Sample& lower, const Sample& upper )
+    {
+        const double seconds = Util::FindRoot(
+                [ this ]( const double t )
+                {
+                    return At( t ).margin;
+                },
+                lower.seconds, lower.margin,
+                upper.seconds, upper.margin,
+                kCrossingTolerance );
+        return At( seconds );
+    }
+
+    /*
+     * the highest elevation in [lower, upper], from the highest sample in it.
+     * FindMaximum stops once the bracket is within twice its tolerance, so
+     * half is passed to narrow the bracket to kMaxElevationTolerance
+     */
+    Sample Highest( const double lower, const Sample& highest, const double upper )
+    {
+        double maximum;
+        const double seconds = Util::FindMaximum(
+                [ this ]( const double t )
+                {
+                    return At( t ).margin;
+                },
+                lower, upper,
+                highest.seconds, highest.margin,
+                0.5 * kMaxElevationTolerance,
+                maximum );
+        return At( seconds );
+    }
+
+private:
+    const SGP4& sgp4_;
+    const Observer& observer_;
+    SGP4::PropagationContext context_;
+    DateTime start_;
+    double min_elevation_;
+    double observer_radius_;
+    double cap_;
+    double max_orbit_rate_;
+    double max_step_;
+};
+}
+
+std::vector< PassDetails > PassPredictor::FindPasses( const SGP4& sgp4,
+                                                      const Observer& observer,
+                                                      const DateTime& start,
+                                                      const DateTime& end,
+                                                      const double min_elevation )
+{
+    std::vector< PassDetails > passes;
+    if ( end <= start )
+    {
+        return passes;
+    }
+
+    Search search( sgp4, observer, start, Util::DegreesToRadians( min_elevation ) );
+    const double duration = ( end - start ).TotalSeconds();
+
+    Sample previous = search.At( 0.0 );
+    bool in_pass = previous.margin >= 0.0;
+
+    PassDetails pass;
+    /*
+     * the highest sample of the current pass and the samples either side
+     */
+    Sample highest = previous;
+    double before_highest = 0.0;
+    bool after_highest_set = false;
+    double after_highest = 0.0;
+
+    if ( in_pass )
+    {
+        pass.aos = start;
+        pass.aos_look_angle = previous.look;
+    }
+
+    while ( previous.seconds < duration )
+    {
+        const double seconds = std::min( duration, previous.seconds + search.Step( previous ) );
+        const Sample current = search.At( seconds );
+
+        if ( !in_pass && current.margin >= 0.0 )
+        {
+            const Sample aos = search.Crossing( previous, current );
+            pass.aos = search.TimeAt( aos.seconds );
+            pass.aos_look_angle = aos.look;
+            in_pass = true;
+
+            highest = current;
+            before_highest = aos.seconds;
+            after_highest_set = false;
+        }
+        else if ( in_pass && current.margin < 0.0 )
+        {
+            const Sample los = search.Crossing( previous, current );
+            pass.los = search.TimeAt( los.seconds );
+            pass.los_look_angle = los.look;
+            in_pass = false;
+
+            const Sample max = search.Highest( before_highest, highest,
+                    after_highest_set ? after_highest : los.seconds );
+            pass.max_elevation_time = search.TimeAt( max.seconds );
+            pass.max_elevation_look_angle = max.look;
+            passes.push_back( pass );
+        }
+        else if ( in_pass )
+        {
+            if ( current.margin > highest.margin )
+            {
+                before_highest = previous.seconds;
+                highest = current;
+                after_highest_set = false;
+            }
+            else if ( !after_highest_set )
+            {
+                after_highest = current.seconds;
+                after_highest_set = true;
+            }
+        }
+
+        previous = current;
+    }
+
+    if ( in_pass )
+    {
+        pass.los = end;
+        pass.los_look_angle = previous.look;
+
+        const Sample max = search.Highest( before_highest, highest,
+                after_highest_set ? after_highest : previous.seconds );
+        pass.max_elevation_time = search.TimeAt( max.seconds );
+        pass.max_elevation_look_angle = max.look;
+        passes.push_back( pass );
+    }
+
+    return passes;
+}
+
+} //namespace SGP4
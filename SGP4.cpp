@@ -21,6 +21,8 @@
 #include <SGP4/SatelliteException.h>
 #include <SGP4/DecayedException.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iomanip>
 
@@ -31,6 +33,20 @@ const SGP4::NearSpaceConstants SGP4::Empty_NearSpaceConstants = SGP4::NearSpaceC
 const SGP4::DeepSpaceConstants SGP4::Empty_DeepSpaceConstants = SGP4::DeepSpaceConstants();
 const SGP4::IntegratorConstants SGP4::Empty_IntegratorConstants = SGP4::IntegratorConstants();
 const SGP4::IntegratorParams SGP4::Empty_IntegratorParams = SGP4::IntegratorParams();
+const size_t SGP4::kLanes;
+
+namespace {
+/*
+ * the generation of the next initialised propagator, from one so a
+ * context with no checkpoint never matches
+ */
+std::atomic<uint64_t> g_next_generation(1);
+}
+
+uint64_t SGP4::NextGeneration()
+{
+    return g_next_generation.fetch_add(1, std::memory_order_relaxed);
+}
 
 void SGP4::SetTle(const Tle& tle)
 {
@@ -48,6 +64,7 @@ void SGP4::Initialise()
      * reset all constants etc
      */
     Reset();
+    generation_ = NextGeneration();
 
     /*
      * error checks
@@ -216,16 +233,45 @@ void SGP4::Initialise()
     }
 }
 
+void SGP4::SaveState(InitialisedState& state) const
+{
+    state.common_consts = common_consts_;
+    state.nearspace_consts = nearspace_consts_;
+    state.deepspace_consts = deepspace_consts_;
+    state.integrator_consts = integrator_consts_;
+    state.use_simple_model = use_simple_model_;
+    state.use_deep_space = use_deep_space_;
+}
+
 Eci SGP4::FindPosition(const DateTime& dt) const
 {
     return FindPosition((dt - elements_.Epoch()).TotalMinutes());
 }
 
 Eci SGP4::FindPosition(double tsince) const
+{
+    PropagationContext context;
+    return FindPosition(context, tsince);
+}
+
+Eci SGP4::FindPosition(PropagationContext& context, const DateTime& dt) const
+{
+    return FindPosition(context, (dt - elements_.Epoch()).TotalMinutes());
+}
+
+Eci SGP4::FindPosition(PropagationContext& context, double tsince) const
 {
     if (use_deep_space_)
     {
-        return FindPositionSDP4(tsince);
+        if (context.generation_ != generation_)
+        {
+            /*
+             * a zero atime makes DeepSpaceSecular restart from epoch
+             */
+            context.generation_ = generation_;
+            context.params_ = Empty_IntegratorParams;
+        }
+        return FindPositionSDP4(context.params_, tsince);
     }
     else
     {
@@ -233,7 +279,7 @@ Eci SGP4::FindPosition(double tsince) const
     }
 }
 
-Eci SGP4::FindPositionSDP4(double tsince) const
+Eci SGP4::FindPositionSDP4(IntegratorParams& params, double tsince) const
 {
     /*
      * the final values
@@ -265,7 +311,7 @@ Eci SGP4::FindPositionSDP4(double tsince) const
     e = elements_.Eccentricity();
     xincl = elements_.Inclination();
 
-    DeepSpaceSecular(tsince, xmdf, omgadf, xnode, e, xincl, xn);
+    DeepSpaceSecular(params, tsince, xmdf, omgadf, xnode, e, xincl, xn);
 
     if (xn <= 0.0)
     {
@@ -615,6 +661,322 @@ Eci SGP4::CalculateFinalPositionVelocity(
     return Eci(elements_.Epoch().AddMinutes(tsince), position, velocity);
 }
 
+void SGP4::FindPositions(
+        const double* tsince,
+        size_t count,
+        Vector* positions,
+        Vector* velocities) const
+{
+    if (use_deep_space_)
+    {
+        PropagationContext context;
+        for (size_t i = 0; i < count; i++)
+        {
+            const Eci eci = FindPosition(context, tsince[i]);
+            positions[i] = eci.Position();
+            velocities[i] = eci.Velocity();
+        }
+    }
+    else
+    {
+        FindPositionsSGP4(tsince, count, positions, velocities);
+    }
+}
+
+void SGP4::FindPositionsSGP4(
+        const double* tsince,
+        size_t count,
+        Vector* positions,
+        Vector* velocities) const
+{
+    /*
+     * every lane holds this propagator, only the times differ
+     */
+    NearSpaceLanes lanes;
+    for (size_t l = 0; l < kLanes; l++)
+    {
+        SetLane(lanes, l);
+    }
+
+    int errors[kLanes];
+
+    for (size_t start = 0; start < count; start += kLanes)
+    {
+        const size_t lane_count = std::min(kLanes, count - start);
+
+        PropagateLanes(lanes, tsince + start, lane_count,
+                positions + start, velocities + start, errors);
+
+        /*
+         * report the first failure the way FindPosition would
+         */
+        for (size_t l = 0; l < lane_count; l++)
+        {
+            switch (errors[l])
+            {
+            case kLaneEccentricity:
+                throw SatelliteException("Error: (e <= -0.001)");
+            case kLaneElsq:
+                throw SatelliteException("Error: (elsq >= 1.0)");
+            case kLanePl:
+                throw SatelliteException("Error: (pl < 0.0)");
+            case kLaneDecayed:
+                throw DecayedException(
+                        elements_.Epoch().AddMinutes(tsince[start + l]),
+                        positions[start + l],
+                        velocities[start + l]);
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void SGP4::SetLane(NearSpaceLanes& lanes, const size_t l) const
+{
+    lanes.mean_anomoly[l] = elements_.MeanAnomoly();
+    lanes.argument_perigee[l] = elements_.ArgumentPerigee();
+    lanes.ascending_node[l] = elements_.AscendingNode();
+    lanes.eccentricity[l] = elements_.Eccentricity();
+    lanes.inclination[l] = elements_.Inclination();
+    lanes.bstar[l] = elements_.BStar();
+    lanes.recovered_semi_major_axis[l] = elements_.RecoveredSemiMajorAxis();
+    lanes.recovered_mean_motion[l] = elements_.RecoveredMeanMotion();
+
+    lanes.cosio[l] = common_consts_.cosio;
+    lanes.sinio[l] = common_consts_.sinio;
+    lanes.eta[l] = common_consts_.eta;
+    lanes.t2cof[l] = common_consts_.t2cof;
+    lanes.x1mth2[l] = common_consts_.x1mth2;
+    lanes.x3thm1[l] = common_consts_.x3thm1;
+    lanes.x7thm1[l] = common_consts_.x7thm1;
+    lanes.aycof[l] = common_consts_.aycof;
+    lanes.xlcof[l] = common_consts_.xlcof;
+    lanes.xnodcf[l] = common_consts_.xnodcf;
+    lanes.c1[l] = common_consts_.c1;
+    lanes.c4[l] = common_consts_.c4;
+    lanes.omgdot[l] = common_consts_.omgdot;
+    lanes.xnodot[l] = common_consts_.xnodot;
+    lanes.xmdot[l] = common_consts_.xmdot;
+
+    /*
+     * the simple model drops these terms, which zero coefficients
+     * leave unchanged without a branch
+     */
+    const bool full_model = !use_simple_model_;
+    lanes.c5[l] = full_model ? nearspace_consts_.c5 : 0.0;
+    lanes.omgcof[l] = full_model ? nearspace_consts_.omgcof : 0.0;
+    lanes.xmcof[l] = full_model ? nearspace_consts_.xmcof : 0.0;
+    lanes.delmo[l] = nearspace_consts_.delmo;
+    lanes.sinmo[l] = nearspace_consts_.sinmo;
+    lanes.d2[l] = full_model ? nearspace_consts_.d2 : 0.0;
+    lanes.d3[l] = full_model ? nearspace_consts_.d3 : 0.0;
+    lanes.d4[l] = full_model ? nearspace_consts_.d4 : 0.0;
+    lanes.t3cof[l] = full_model ? nearspace_consts_.t3cof : 0.0;
+    lanes.t4cof[l] = full_model ? nearspace_consts_.t4cof : 0.0;
+    lanes.t5cof[l] = full_model ? nearspace_consts_.t5cof : 0.0;
+}
+
+void SGP4::PropagateLanes(
+        const NearSpaceLanes& c,
+        const double* tsince,
+        const size_t lanes,
+        Vector* positions,
+        Vector* velocities,
+        int* errors)
+{
+    double e[kLanes];
+    double a[kLanes];
+    double omega[kLanes];
+    double xl[kLanes];
+    double xnode[kLanes];
+
+    /*
+     * update for secular gravity and atmospheric drag,
+     * as FindPositionSGP4
+     */
+    for (size_t l = 0; l < lanes; l++)
+    {
+        const double t = tsince[l];
+        const double xmdf = c.mean_anomoly[l] + c.xmdot[l] * t;
+        const double omgadf = c.argument_perigee[l] + c.omgdot[l] * t;
+        const double xnoddf = c.ascending_node[l] + c.xnodot[l] * t;
+
+        const double tsq = t * t;
+        xnode[l] = xnoddf + c.xnodcf[l] * tsq;
+        double tempa = 1.0 - c.c1[l] * t;
+        double tempe = c.bstar[l] * c.c4[l] * t;
+        double templ = c.t2cof[l] * tsq;
+
+        const double delomg = c.omgcof[l] * t;
+        const double delm = c.xmcof[l]
+            * (pow(1.0 + c.eta[l] * cos(xmdf), 3.0) * - c.delmo[l]);
+        const double temp = delomg + delm;
+
+        const double xmp = xmdf + temp;
+        omega[l] = omgadf - temp;
+
+        const double tcube = tsq * t;
+        const double tfour = t * tcube;
+
+        tempa = tempa - c.d2[l] * tsq - c.d3[l] * tcube - c.d4[l] * tfour;
+        tempe += c.bstar[l] * c.c5[l] * (sin(xmp) - c.sinmo[l]);
+        templ += c.t3cof[l] * tcube + tfour * (c.t4cof[l] + t * c.t5cof[l]);
+
+        a[l] = c.recovered_semi_major_axis[l] * tempa * tempa;
+        const double el = c.eccentricity[l] - tempe;
+        xl[l] = xmp + omega[l] + xnode[l] + c.recovered_mean_motion[l] * templ;
+
+        /*
+         * fix tolerance for error recognition
+         */
+        errors[l] = el <= -0.001 ? kLaneEccentricity : kLaneOk;
+        e[l] = std::min(std::max(el, 1.0e-6), 1.0 - 1.0e-6);
+    }
+
+    /*
+     * long period periodics, as CalculateFinalPositionVelocity
+     */
+    double xn[kLanes];
+    double axn[kLanes];
+    double ayn[kLanes];
+    double elsq[kLanes];
+    double capu[kLanes];
+    double max_newton_naphson[kLanes];
+    for (size_t l = 0; l < lanes; l++)
+    {
+        const double beta2 = 1.0 - e[l] * e[l];
+        xn[l] = kXKE / pow(a[l], 1.5);
+        axn[l] = e[l] * cos(omega[l]);
+        const double temp11 = 1.0 / (a[l] * beta2);
+        const double xll = temp11 * c.xlcof[l] * axn[l];
+        const double aynl = temp11 * c.aycof[l];
+        const double xlt = xl[l] + xll;
+        ayn[l] = e[l] * sin(omega[l]) + aynl;
+        elsq[l] = axn[l] * axn[l] + ayn[l] * ayn[l];
+        capu[l] = fmod(xlt - xnode[l], kTWOPI);
+        max_newton_naphson[l] = 1.25 * fabs(sqrt(elsq[l]));
+
+        if (errors[l] == kLaneOk && elsq[l] >= 1.0)
+        {
+            errors[l] = kLaneElsq;
+        }
+    }
+
+    /*
+     * solve keplers equation for every lane with the same iterations.
+     * a lane stops moving once converged, so recomputing it yields the
+     * same terms FindPosition stopped at
+     */
+    double epw[kLanes];
+    double sinepw[kLanes];
+    double cosepw[kLanes];
+    double ecose[kLanes];
+    double esine[kLanes];
+    for (size_t l = 0; l < lanes; l++)
+    {
+        epw[l] = capu[l];
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        int running = 0;
+        for (size_t l = 0; l < lanes; l++)
+        {
+            sinepw[l] = sin(epw[l]);
+            cosepw[l] = cos(epw[l]);
+            ecose[l] = axn[l] * cosepw[l] + ayn[l] * sinepw[l];
+            esine[l] = axn[l] * sinepw[l] - ayn[l] * cosepw[l];
+
+            const double f = capu[l] - epw[l] + esine[l];
+            const double fdot = 1.0 - ecose[l];
+            double delta_epw = f / fdot;
+
+            if (i == 0)
+            {
+                delta_epw = std::min(std::max(delta_epw, -max_newton_naphson[l]),
+                        max_newton_naphson[l]);
+            }
+            else
+            {
+                delta_epw = f / (fdot + 0.5 * esine[l] * delta_epw);
+            }
+
+            const bool lane_running = fabs(f) >= 1.0e-12;
+            epw[l] += lane_running ? delta_epw : 0.0;
+            running |= lane_running;
+        }
+
+        if (!running)
+        {
+            break;
+        }
+    }
+
+    /*
+     * short period periodics and final position / velocity
+     */
+    for (size_t l = 0; l < lanes; l++)
+    {
+        const double temp21 = 1.0 - elsq[l];
+        const double pl = a[l] * temp21;
+
+        const double r = a[l] * (1.0 - ecose[l]);
+        const double temp31 = 1.0 / r;
+        const double rdot = kXKE * sqrt(a[l]) * esine[l] * temp31;
+        const double rfdot = kXKE * sqrt(pl) * temp31;
+        const double temp32 = a[l] * temp31;
+        const double betal = sqrt(temp21);
+        const double temp33 = 1.0 / (1.0 + betal);
+        const double cosu = temp32 * (cosepw[l] - axn[l] + ayn[l] * esine[l] * temp33);
+        const double sinu = temp32 * (sinepw[l] - ayn[l] - axn[l] * esine[l] * temp33);
+        const double u = atan2(sinu, cosu);
+        const double sin2u = 2.0 * sinu * cosu;
+        const double cos2u = 2.0 * cosu * cosu - 1.0;
+
+        const double temp41 = 1.0 / pl;
+        const double temp42 = kCK2 * temp41;
+        const double temp43 = temp42 * temp41;
+
+        const double rk = r * (1.0 - 1.5 * temp43 * betal * c.x3thm1[l])
+            + 0.5 * temp42 * c.x1mth2[l] * cos2u;
+        const double uk = u - 0.25 * temp43 * c.x7thm1[l] * sin2u;
+        const double xnodek = xnode[l] + 1.5 * temp43 * c.cosio[l] * sin2u;
+        const double xinck = c.inclination[l]
+            + 1.5 * temp43 * c.cosio[l] * c.sinio[l] * cos2u;
+        const double rdotk = rdot - xn[l] * temp42 * c.x1mth2[l] * sin2u;
+        const double rfdotk = rfdot + xn[l] * temp42
+            * (c.x1mth2[l] * cos2u + 1.5 * c.x3thm1[l]);
+
+        const double sinuk = sin(uk);
+        const double cosuk = cos(uk);
+        const double sinik = sin(xinck);
+        const double cosik = cos(xinck);
+        const double sinnok = sin(xnodek);
+        const double cosnok = cos(xnodek);
+        const double xmx = -sinnok * cosik;
+        const double xmy = cosnok * cosik;
+        const double ux = xmx * sinuk + cosnok * cosuk;
+        const double uy = xmy * sinuk + sinnok * cosuk;
+        const double uz = sinik * sinuk;
+        const double vx = xmx * cosuk - cosnok * sinuk;
+        const double vy = xmy * cosuk - sinnok * sinuk;
+        const double vz = sinik * cosuk;
+
+        positions[l] = Vector(rk * ux * kXKMPER,
+                rk * uy * kXKMPER,
+                rk * uz * kXKMPER);
+        velocities[l] = Vector((rdotk * ux + rfdotk * vx) * kXKMPER / 60.0,
+                (rdotk * uy + rfdotk * vy) * kXKMPER / 60.0,
+                (rdotk * uz + rfdotk * vz) * kXKMPER / 60.0);
+
+        if (errors[l] == kLaneOk)
+        {
+            errors[l] = pl < 0.0 ? kLanePl : (rk < 1.0 ? kLaneDecayed : kLaneOk);
+        }
+    }
+}
+
 static inline double EvaluateCubicPolynomial(
         const double x,
         const double constant,
@@ -1025,13 +1387,14 @@ void SGP4::DeepSpaceInitialise(
          * initialise integrator
          */
         integrator_consts_.xfact = bfact - elements_.RecoveredMeanMotion();
-        integrator_params_.atime = 0.0;
-        integrator_params_.xni = elements_.RecoveredMeanMotion();
-        integrator_params_.xli = integrator_consts_.xlamo;
+        IntegratorParams epoch_params = Empty_IntegratorParams;
+        epoch_params.atime = 0.0;
+        epoch_params.xni = elements_.RecoveredMeanMotion();
+        epoch_params.xli = integrator_consts_.xlamo;
         /*
          * precompute dot terms for epoch
          */
-        DeepSpaceCalcDotTerms(integrator_consts_.values_0);
+        DeepSpaceCalcDotTerms(epoch_params, integrator_consts_.values_0);
     }
 }
 
@@ -1206,6 +1569,7 @@ void SGP4::DeepSpacePeriodics(
 }
 
 void SGP4::DeepSpaceSecular(
+        IntegratorParams& params,
         const double tsince,
         double& xll,
         double& omgasm,
@@ -1227,39 +1591,39 @@ void SGP4::DeepSpaceSecular(
     {
         /*
          * 1st condition (if tsince is less than one time step from epoch)
-         * 2nd condition (if integrator_params_.atime and
+         * 2nd condition (if params.atime and
          *     tsince are of opposite signs, so zero crossing required)
          * 3rd condition (if tsince is closer to zero than 
-         *     integrator_params_.atime, only integrate away from zero)
+         *     params.atime, only integrate away from zero)
          */
         if (fabs(tsince) < STEP ||
-                tsince * integrator_params_.atime <= 0.0 ||
-                fabs(tsince) < fabs(integrator_params_.atime))
+                tsince * params.atime <= 0.0 ||
+                fabs(tsince) < fabs(params.atime))
         {
             /*
              * restart from epoch
              */
-            integrator_params_.atime = 0.0;
-            integrator_params_.xni = elements_.RecoveredMeanMotion();
-            integrator_params_.xli = integrator_consts_.xlamo;
+            params.atime = 0.0;
+            params.xni = elements_.RecoveredMeanMotion();
+            params.xli = integrator_consts_.xlamo;
 
             /*
              * restore precomputed values for epoch
              */
-            integrator_params_.values_t = integrator_consts_.values_0;
+            params.values_t = integrator_consts_.values_0;
         }
 
-        double ft = tsince - integrator_params_.atime;
+        double ft = tsince - params.atime;
 
         /*
          * if time difference (ft) is greater than the time step (720.0)
-         * loop around until integrator_params_.atime is within one time step of
+         * loop around until params.atime is within one time step of
          * tsince
          */
         if (fabs(ft) >= STEP)
         {
             /*
-             * calculate step direction to allow integrator_params_.atime
+             * calculate step direction to allow params.atime
              * to catch up with tsince
              */
             double delt = -STEP;
@@ -1273,26 +1637,26 @@ void SGP4::DeepSpaceSecular(
                 /*
                  * integrate using current dot terms
                  */
-                DeepSpaceIntegrator(delt, STEP2, integrator_params_.values_t);
+                DeepSpaceIntegrator(params, delt, STEP2, params.values_t);
 
                 /*
                  * calculate dot terms for next integration
                  */
-                DeepSpaceCalcDotTerms(integrator_params_.values_t);
+                DeepSpaceCalcDotTerms(params, params.values_t);
 
-                ft = tsince - integrator_params_.atime;
+                ft = tsince - params.atime;
             } while (fabs(ft) >= STEP);
         }
 
         /*
          * integrator
          */
-        xn = integrator_params_.xni 
-            + integrator_params_.values_t.xndot * ft
-            + integrator_params_.values_t.xnddt * ft * ft * 0.5;
-        const double xl = integrator_params_.xli
-            + integrator_params_.values_t.xldot * ft
-            + integrator_params_.values_t.xndot * ft * ft * 0.5;
+        xn = params.xni 
+            + params.values_t.xndot * ft
+            + params.values_t.xnddt * ft * ft * 0.5;
+        const double xl = params.xli
+            + params.values_t.xldot * ft
+            + params.values_t.xndot * ft * ft * 0.5;
         const double temp = -xnodes + deepspace_consts_.gsto + tsince * kTHDT;
 
         if (deepspace_consts_.synchronous_flag)
@@ -1306,7 +1670,9 @@ void SGP4::DeepSpaceSecular(
     }
 }
 
-void SGP4::DeepSpaceCalcDotTerms(struct IntegratorValues& values) const
+void SGP4::DeepSpaceCalcDotTerms(
+        const struct IntegratorParams& params,
+        struct IntegratorValues& values) const
 {
     static const double G22 = 5.7686396;
     static const double G32 = 0.95240898;
@@ -1321,57 +1687,57 @@ void SGP4::DeepSpaceCalcDotTerms(struct IntegratorValues& values) const
     {
 
         values.xndot = deepspace_consts_.del1
-            * sin(integrator_params_.xli - FASX2)
+            * sin(params.xli - FASX2)
             + deepspace_consts_.del2
-            * sin(2.0 * (integrator_params_.xli - FASX4))
+            * sin(2.0 * (params.xli - FASX4))
             + deepspace_consts_.del3
-            * sin(3.0 * (integrator_params_.xli - FASX6));
+            * sin(3.0 * (params.xli - FASX6));
         values.xnddt = deepspace_consts_.del1
-            * cos(integrator_params_.xli - FASX2)
+            * cos(params.xli - FASX2)
             + 2.0 * deepspace_consts_.del2
-            * cos(2.0 * (integrator_params_.xli - FASX4))
+            * cos(2.0 * (params.xli - FASX4))
             + 3.0 * deepspace_consts_.del3
-            * cos(3.0 * (integrator_params_.xli - FASX6));
+            * cos(3.0 * (params.xli - FASX6));
     }
     else
     {
         const double xomi = elements_.ArgumentPerigee()
-            + common_consts_.omgdot * integrator_params_.atime;
+            + common_consts_.omgdot * params.atime;
         const double x2omi = xomi + xomi;
-        const double x2li = integrator_params_.xli + integrator_params_.xli;
+        const double x2li = params.xli + params.xli;
 
         values.xndot = deepspace_consts_.d2201
-            * sin(x2omi + integrator_params_.xli - G22)
+            * sin(x2omi + params.xli - G22)
             * + deepspace_consts_.d2211
-            * sin(integrator_params_.xli - G22)
+            * sin(params.xli - G22)
             + deepspace_consts_.d3210
-            * sin(xomi + integrator_params_.xli - G32)
+            * sin(xomi + params.xli - G32)
             + deepspace_consts_.d3222
-            * sin(-xomi + integrator_params_.xli - G32)
+            * sin(-xomi + params.xli - G32)
             + deepspace_consts_.d4410
             * sin(x2omi + x2li - G44)
             + deepspace_consts_.d4422
             * sin(x2li - G44)
             + deepspace_consts_.d5220
-            * sin(xomi + integrator_params_.xli - G52)
+            * sin(xomi + params.xli - G52)
             + deepspace_consts_.d5232
-            * sin(-xomi + integrator_params_.xli - G52)
+            * sin(-xomi + params.xli - G52)
             + deepspace_consts_.d5421
             * sin(xomi + x2li - G54)
             + deepspace_consts_.d5433
             * sin(-xomi + x2li - G54);
         values.xnddt = deepspace_consts_.d2201
-            * cos(x2omi + integrator_params_.xli - G22)
+            * cos(x2omi + params.xli - G22)
             + deepspace_consts_.d2211
-            * cos(integrator_params_.xli - G22)
+            * cos(params.xli - G22)
             + deepspace_consts_.d3210
-            * cos(xomi + integrator_params_.xli - G32)
+            * cos(xomi + params.xli - G32)
             + deepspace_consts_.d3222
-            * cos(-xomi + integrator_params_.xli - G32)
+            * cos(-xomi + params.xli - G32)
             + deepspace_consts_.d5220
-            * cos(xomi + integrator_params_.xli - G52)
+            * cos(xomi + params.xli - G52)
             + deepspace_consts_.d5232
-            * cos(-xomi + integrator_params_.xli - G52)
+            * cos(-xomi + params.xli - G52)
             + 2.0 * (deepspace_consts_.d4410 * cos(x2omi + x2li - G44)
             + deepspace_consts_.d4422
             * cos(x2li - G44)
@@ -1381,11 +1747,12 @@ void SGP4::DeepSpaceCalcDotTerms(struct IntegratorValues& values) const
             * cos(-xomi + x2li - G54));
     }
 
-    values.xldot = integrator_params_.xni + integrator_consts_.xfact;
+    values.xldot = params.xni + integrator_consts_.xfact;
     values.xnddt *= values.xldot;
 }
 
 void SGP4::DeepSpaceIntegrator(
+        struct IntegratorParams& params,
         const double delt,
         const double step2,
         const struct IntegratorValues &values) const
@@ -1393,13 +1760,13 @@ void SGP4::DeepSpaceIntegrator(
     /*
      * integrator
      */
-    integrator_params_.xli += values.xldot * delt + values.xndot * step2;
-    integrator_params_.xni += values.xndot * delt + values.xnddt * step2;
+    params.xli += values.xldot * delt + values.xndot * step2;
+    params.xni += values.xndot * delt + values.xnddt * step2;
 
     /*
      * increment integrator time
      */
-    integrator_params_.atime += delt;
+    params.atime += delt;
 }
 
 void SGP4::Reset()
@@ -1411,7 +1778,6 @@ void SGP4::Reset()
     nearspace_consts_  = Empty_NearSpaceConstants;
     deepspace_consts_  = Empty_DeepSpaceConstants;
     integrator_consts_ = Empty_IntegratorConstants;
-    integrator_params_ = Empty_IntegratorParams;
 }
 
 } //namespace SGP4
\ No newline at end of file
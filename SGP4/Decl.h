@@ -1,6 +1,8 @@
 #pragma once
 
+#ifndef SGP4_DYNLINK
 #define SGP4_DYNLINK 0
+#endif
 
 #if defined( _MSC_VER ) || defined( __MINGW32__ ) || defined( __MINGW64__ )
 #    if SGP4_DYNLINK
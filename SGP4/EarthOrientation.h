@@ -0,0 +1,113 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef EARTHORIENTATION_H_
+#define EARTHORIENTATION_H_
+
+#include "DateTime.h"
+#include "Util.h"
+#include "Vector.h"
+
+#include <cmath>
+
+namespace SGP4 {
+
+/**
+ * @brief The rotation of the earth at a particular time.
+ *
+ * Holds the greenwich mean sidereal time of a date with its sine and cosine,
+ * so conversions between the inertial and earth fixed frames at the same
+ * date can share one evaluation of the sidereal time polynomial.
+ */
+class SGP4_DECL EarthOrientation
+{
+public:
+    /**
+     * @param[in] dt the date
+     */
+    explicit EarthOrientation( const DateTime& dt )
+        : m_dt( dt )
+        , m_gmst( dt.ToGreenwichSiderealTime() )
+        , m_sin_gmst( sin( m_gmst ) )
+        , m_cos_gmst( cos( m_gmst ) )
+    {
+    }
+
+    /**
+     * @returns the date
+     */
+    DateTime GetDateTime() const
+    {
+        return m_dt;
+    }
+
+    /**
+     * @returns the greenwich mean sidereal time in radians
+     */
+    double Gmst() const
+    {
+        return m_gmst;
+    }
+
+    /**
+     * @returns the sine of the greenwich mean sidereal time
+     */
+    double SinGmst() const
+    {
+        return m_sin_gmst;
+    }
+
+    /**
+     * @returns the cosine of the greenwich mean sidereal time
+     */
+    double CosGmst() const
+    {
+        return m_cos_gmst;
+    }
+
+    /**
+     * @param[in] lon the longitude in radians
+     * @returns the local mean sidereal time at the longitude
+     */
+    double LocalMeanSiderealTime( const double lon ) const
+    {
+        return Util::WrapTwoPI( m_gmst + lon );
+    }
+
+    /**
+     * Rotate an inertial position into the earth fixed frame
+     * @param[in] eci the inertial position
+     * @returns the earth fixed position
+     */
+    Vector ToEarthFixed( const Vector& eci ) const
+    {
+        return Vector( m_cos_gmst * eci.x + m_sin_gmst * eci.y,
+                       -m_sin_gmst * eci.x + m_cos_gmst * eci.y,
+                       eci.z );
+    }
+
+private:
+    DateTime m_dt;
+    double m_gmst;
+    double m_sin_gmst;
+    double m_cos_gmst;
+};
+
+} //namespace SGP4
+
+#endif
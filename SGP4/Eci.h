@@ -21,6 +21,7 @@
 #include "CoordGeodetic.h"
 #include "Vector.h"
 #include "DateTime.h"
+#include "EarthOrientation.h"
 
 namespace SGP4 {
 
@@ -55,7 +56,7 @@ public:
          const double longitude,
          const double altitude )
     {
-        ToEci( dt, CoordGeodetic( latitude, longitude, altitude ) );
+        ToEci( EarthOrientation( dt ), CoordGeodetic( latitude, longitude, altitude ) );
     }
 
     /**
@@ -64,7 +65,17 @@ public:
      */
     Eci( const DateTime& dt, const CoordGeodetic& geo )
     {
-        ToEci( dt, geo );
+        ToEci( EarthOrientation( dt ), geo );
+    }
+
+    /**
+     * @param[in] orientation the earth orientation at the date to be used
+     * for this position
+     * @param[in] geo the position
+     */
+    Eci( const EarthOrientation& orientation, const CoordGeodetic& geo )
+    {
+        ToEci( orientation, geo );
     }
 
     /**
@@ -116,7 +127,17 @@ public:
      */
     void Update( const DateTime& dt, const CoordGeodetic& geo )
     {
-        ToEci( dt, geo );
+        ToEci( EarthOrientation( dt ), geo );
+    }
+
+    /**
+     * Update this object with a new date and geodetic position
+     * @param orientation the earth orientation at the new date
+     * @param geo new geodetic position
+     */
+    void Update( const EarthOrientation& orientation, const CoordGeodetic& geo )
+    {
+        ToEci( orientation, geo );
     }
 
     /**
@@ -144,12 +165,73 @@ public:
     }
 
     /**
+     * Find where a geodetic position lies relative to the earth's axis,
+     * taking into account earth flattening
+     * @param[in] geo the geodetic position
+     * @param[out] axis_distance the distance from the earth's axis in
+     * kilometres
+     * @param[out] equator_distance the distance north of the equatorial
+     * plane in kilometres
+     */
+    static void EarthFixedDistances( const CoordGeodetic& geo,
+                                     double& axis_distance,
+                                     double& equator_distance );
+
+    /**
+     * @brief How ToGeodetic solves for the geodetic latitude.
+     *
+     * Iterative repeats a fixed point step until the latitude changes by
+     * less than 1e-10 radians, up to 10 times. Bowring takes a single step
+     * from Bowring's 1985 starting point, with no trigonometry besides
+     * atan2, and is about three times faster. Up to lunar distance its
+     * latitude is within 1e-12 radians and its altitude within 0.001 mm of
+     * the exact solution, no worse than Iterative.
+     */
+    enum class GeodeticMethod
+    {
+        Iterative,
+        Bowring
+    };
+
+    /**
+     * @param[in] method how to solve for the latitude
+     * @returns the position in geodetic form
+     */
+    CoordGeodetic ToGeodetic( GeodeticMethod method = GeodeticMethod::Iterative ) const;
+
+    /**
+     * @param[in] orientation the earth orientation at the date of this
+     * position
+     * @param[in] method how to solve for the latitude
      * @returns the position in geodetic form
      */
-    CoordGeodetic ToGeodetic() const;
+    CoordGeodetic ToGeodetic( const EarthOrientation& orientation,
+                              GeodeticMethod method = GeodeticMethod::Iterative ) const
+    {
+        return ToGeodetic( orientation.Gmst(), method );
+    }
+
+    /**
+     * Convert count positions at the same date to geodetic form. Like the
+     * single position overloads this iterates by default. The Bowring loop
+     * has no branches or calls besides sqrt and atan2, so compilers
+     * vectorise it given a vector atan2, as gcc does with -ffast-math
+     * against glibc's libmvec.
+     * @param[in] orientation the earth orientation at the date
+     * @param[in] positions the positions in kilometres
+     * @param[in] count the number of positions
+     * @param[out] geodetic count geodetic positions
+     * @param[in] method how to solve for the latitude
+     */
+    static void ToGeodetic( const EarthOrientation& orientation,
+                            const Vector* positions,
+                            size_t count,
+                            CoordGeodetic* geodetic,
+                            GeodeticMethod method = GeodeticMethod::Iterative );
 
 private:
-    void ToEci( const DateTime& dt, const CoordGeodetic& geo );
+    void ToEci( const EarthOrientation& orientation, const CoordGeodetic& geo );
+    CoordGeodetic ToGeodetic( double gmst, GeodeticMethod method ) const;
 
     DateTime m_dt;
     Vector m_position;
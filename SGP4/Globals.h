@@ -69,6 +69,10 @@ const double kOMEGA_E = 1.00273790934;
 const double kAU = 1.49597870691e8;
 
 const double kSECONDS_PER_DAY = 86400.0;
+/*
+ * earth rotation in radians per second
+ */
+const double kEARTH_ROTATION = kTWOPI * ( kOMEGA_E / kSECONDS_PER_DAY );
 const double kMINUTES_PER_DAY = 1440.0;
 const double kHOURS_PER_DAY = 24.0;
 
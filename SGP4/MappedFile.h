@@ -0,0 +1,81 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include "Decl.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief A read only view of a whole file.
+ *
+ * The file is memory mapped where the platform allows, otherwise it is
+ * read into memory. The data is aligned for any type.
+ */
+class SGP4_DECL MappedFile
+{
+public:
+    /**
+     * Constructor for an empty file
+     */
+    MappedFile();
+
+    /**
+     * Constructor
+     * @param[in] filename the file to map
+     * @param[in] sequential whether the file will be read front to back
+     * @exception TleException if the file cannot be read
+     */
+    explicit MappedFile( const std::string& filename, bool sequential = false );
+
+    ~MappedFile();
+
+    /**
+     * @returns the contents of the file
+     */
+    const char* Data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @returns the size of the file
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+private:
+    MappedFile( const MappedFile& );
+    MappedFile& operator=( const MappedFile& );
+
+    const char* m_data;
+    size_t m_size;
+    void* m_mapping;
+    std::vector< char > m_buffer;
+};
+
+} //namespace SGP4
+
+#endif
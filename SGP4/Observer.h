@@ -21,13 +21,19 @@
 #include "CoordGeodetic.h"
 #include "Eci.h"
 
+#include <cstddef>
+
 namespace SGP4 {
 
 class DateTime;
 struct CoordTopocentric;
 
 /**
- * @brief Stores an observers location in Eci coordinates.
+ * @brief Stores an observers location.
+ *
+ * The time independent geometry of the location is computed once, so
+ * GetLookAngle does not modify the observer and one observer may be shared
+ * between threads.
  */
 class SGP4_DECL Observer
 {
@@ -42,8 +48,8 @@ public:
               const double longitude,
               const double altitude )
         : m_geo( latitude, longitude, altitude )
-        , m_eci( DateTime(), m_geo )
     {
+        Initialise();
     }
 
     /**
@@ -52,8 +58,8 @@ public:
      */
     Observer( const CoordGeodetic &geo )
         : m_geo( geo )
-        , m_eci( DateTime(), geo )
     {
+        Initialise();
     }
 
     /**
@@ -63,7 +69,7 @@ public:
     void SetLocation( const CoordGeodetic& geo )
     {
         m_geo = geo;
-        m_eci.Update( m_eci.GetDateTime(), m_geo );
+        Initialise();
     }
 
     /**
@@ -80,24 +86,51 @@ public:
      * @param[in] eci the object to find the look angle to
      * @returns the lookup angle
      */
-    CoordTopocentric GetLookAngle( const Eci &eci );
+    CoordTopocentric GetLookAngle( const Eci &eci ) const;
 
-private:
     /**
-     * @param[in] dt the date to update the observers position for
+     * Get the look angle for the observers position to the object, with the
+     * earth orientation at the date of the object already found
+     * @param[in] eci the object to find the look angle to
+     * @param[in] orientation the earth orientation at the date of eci
+     * @returns the lookup angle
      */
-    void Update( const DateTime &dt )
-    {
-        if ( m_eci != dt )
-        {
-            m_eci.Update( dt, m_geo );
-        }
-    }
+    CoordTopocentric GetLookAngle( const Eci &eci,
+                                   const EarthOrientation& orientation ) const;
+
+    /**
+     * Get the look angles for the observers position to many objects, as
+     * GetLookAngle would for each. Where samples are evenly spaced in time,
+     * as along a pass, the sidereal angle is evaluated once per block of
+     * samples and advanced from one to the next by a fixed rotation, and
+     * each block's transform is a loop that can be vectorised. Results
+     * agree with GetLookAngle to within the rounding of its sidereal time,
+     * a few nanoradians of earth rotation
+     * @param[in] ecis count objects
+     * @param[in] count the number of objects
+     * @param[out] look_angles count look angles
+     */
+    void GetLookAngles( const Eci* ecis,
+                        size_t count,
+                        CoordTopocentric* look_angles ) const;
+
+private:
+    void Initialise();
 
     /** the observers position */
     CoordGeodetic m_geo;
-    /** the observers Eci for a particular time */
-    Eci m_eci;
+    /** sine of the observers latitude */
+    double m_sin_lat;
+    /** cosine of the observers latitude */
+    double m_cos_lat;
+    /** sine of the observers longitude */
+    double m_sin_lon;
+    /** cosine of the observers longitude */
+    double m_cos_lon;
+    /** the observers distance from the earths axis in kilometers */
+    double m_axis_distance;
+    /** the observers distance from the equatorial plane in kilometers */
+    double m_equator_distance;
 };
 
 } //namespace SGP4
@@ -24,6 +24,7 @@
 namespace SGP4 {
 
 class Tle;
+struct TleRecord;
 
 /**
  * @brief The extracted orbital elements used by the SGP4 propagator.
@@ -32,6 +33,7 @@ class SGP4_DECL OrbitalElements
 {
 public:
     OrbitalElements( const Tle& tle );
+    OrbitalElements( const TleRecord& record );
 
     /*
      * XMO
@@ -130,6 +132,8 @@ public:
     }
 
 private:
+    void Initialise();
+
     double mean_anomoly_;
     double ascending_node_;
     double argument_perigee_;
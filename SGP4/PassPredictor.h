@@ -0,0 +1,76 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PASSPREDICTOR_H_
+#define PASSPREDICTOR_H_
+
+#include "CoordTopocentric.h"
+#include "DateTime.h"
+#include "Observer.h"
+#include "SGP4.h"
+
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief A pass of a satellite over an observer.
+ */
+struct PassDetails
+{
+    /** acquisition of signal, the start of the search if already in view */
+    DateTime aos;
+    /** loss of signal, the end of the search if still in view */
+    DateTime los;
+    /** the time of the highest elevation */
+    DateTime max_elevation_time;
+    CoordTopocentric aos_look_angle;
+    CoordTopocentric los_look_angle;
+    CoordTopocentric max_elevation_look_angle;
+};
+
+/**
+ * @brief Finds the passes of a satellite over an observer.
+ */
+class SGP4_DECL PassPredictor
+{
+public:
+    /**
+     * Find every pass above a minimum elevation.
+     *
+     * Away from the observer the search steps by the least time the orbit
+     * needs to bring the satellite into view, near it by the least time
+     * the elevation needs to reach the minimum. Crossings are then refined
+     * to a millisecond and the highest elevation to a tenth of a second.
+     * @param[in] sgp4 the satellite
+     * @param[in] observer the observer
+     * @param[in] start the start of the search
+     * @param[in] end the end of the search
+     * @param[in] min_elevation the minimum elevation in degrees
+     * @returns the passes in time order
+     * @exception SatelliteException, DecayedException from SGP4
+     */
+    static std::vector< PassDetails > FindPasses( const SGP4& sgp4,
+                                                  const Observer& observer,
+                                                  const DateTime& start,
+                                                  const DateTime& end,
+                                                  double min_elevation );
+};
+
+} //namespace SGP4
+
+#endif
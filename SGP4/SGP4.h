@@ -24,6 +24,9 @@
 #include "SatelliteException.h"
 #include "DecayedException.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace SGP4 {
 
  /**
@@ -38,11 +41,47 @@ public:
         Initialise();
     }
 
+    SGP4( const OrbitalElements& elements )
+        : elements_( elements )
+    {
+        Initialise();
+    }
+
+    class PropagationContext;
+
     void SetTle( const Tle& tle );
+
+    /**
+     * @returns the elements being propagated
+     */
+    const OrbitalElements& Elements() const
+    {
+        return elements_;
+    }
+
+    /*
+     * deep space resonant orbits are integrated from epoch on every call,
+     * pass a PropagationContext to continue from the previous call instead
+     */
     Eci FindPosition( double tsince ) const;
     Eci FindPosition( const DateTime& date ) const;
+    Eci FindPosition( PropagationContext& context, double tsince ) const;
+    Eci FindPosition( PropagationContext& context, const DateTime& date ) const;
+    /*
+     * find the position (km) and velocity (km/s) for each of count times
+     * since epoch (minutes). throws as FindPosition would for the first
+     * time that fails, after filling in the times before it
+     */
+    void FindPositions(
+        const double* tsince,
+        size_t count,
+        Vector* positions,
+        Vector* velocities ) const;
 
 private:
+    friend class SatelliteBatch;
+    friend class TleSnapshot;
+
     struct CommonConstants
     {
         double cosio;
@@ -184,9 +223,125 @@ private:
         struct IntegratorValues values_t;
     };
 
+    /*
+     * everything Initialise derives from the elements, as plain data that
+     * can be stored and restored byte for byte
+     */
+    struct InitialisedState
+    {
+        struct CommonConstants common_consts;
+        struct NearSpaceConstants nearspace_consts;
+        struct DeepSpaceConstants deepspace_consts;
+        struct IntegratorConstants integrator_consts;
+        bool use_simple_model;
+        bool use_deep_space;
+    };
+
+    /*
+     * restore a propagator without repeating Initialise
+     */
+    SGP4( const OrbitalElements& elements, const InitialisedState& state )
+        : common_consts_( state.common_consts )
+        , nearspace_consts_( state.nearspace_consts )
+        , deepspace_consts_( state.deepspace_consts )
+        , integrator_consts_( state.integrator_consts )
+        , elements_( elements )
+        , use_simple_model_( state.use_simple_model )
+        , use_deep_space_( state.use_deep_space )
+        , generation_( NextGeneration() )
+    {
+    }
+
+    void SaveState( InitialisedState& state ) const;
+
+    /*
+     * near space propagations run together by PropagateLanes
+     */
+    static const size_t kLanes = 16;
+
+    /*
+     * elements and constants of up to kLanes near space propagations, one
+     * entry per lane. each stage of PropagateLanes is a loop over lanes with
+     * no calls or early exits, so it can be vectorised across them
+     */
+    struct NearSpaceLanes
+    {
+        double mean_anomoly[kLanes];
+        double argument_perigee[kLanes];
+        double ascending_node[kLanes];
+        double eccentricity[kLanes];
+        double inclination[kLanes];
+        double bstar[kLanes];
+        double recovered_semi_major_axis[kLanes];
+        double recovered_mean_motion[kLanes];
+
+        double cosio[kLanes];
+        double sinio[kLanes];
+        double eta[kLanes];
+        double t2cof[kLanes];
+        double x1mth2[kLanes];
+        double x3thm1[kLanes];
+        double x7thm1[kLanes];
+        double aycof[kLanes];
+        double xlcof[kLanes];
+        double xnodcf[kLanes];
+        double c1[kLanes];
+        double c4[kLanes];
+        double omgdot[kLanes];
+        double xnodot[kLanes];
+        double xmdot[kLanes];
+
+        double c5[kLanes];
+        double omgcof[kLanes];
+        double xmcof[kLanes];
+        double delmo[kLanes];
+        double sinmo[kLanes];
+        double d2[kLanes];
+        double d3[kLanes];
+        double d4[kLanes];
+        double t3cof[kLanes];
+        double t4cof[kLanes];
+        double t5cof[kLanes];
+    };
+
+    /*
+     * per lane outcome of PropagateLanes
+     */
+    enum LaneError
+    {
+        kLaneOk = 0,
+        kLaneEccentricity,
+        kLaneElsq,
+        kLanePl,
+        kLaneDecayed
+    };
+
     void Initialise();
-    Eci FindPositionSDP4( const double tsince ) const;
+    /**
+     * @returns a generation no other propagator has had
+     */
+    static uint64_t NextGeneration();
+    Eci FindPositionSDP4( struct IntegratorParams& params, const double tsince ) const;
     Eci FindPositionSGP4( double tsince ) const;
+    void FindPositionsSGP4(
+        const double* tsince,
+        size_t count,
+        Vector* positions,
+        Vector* velocities ) const;
+    /**
+     * Copy this near space propagator into lane l
+     */
+    void SetLane( NearSpaceLanes& lanes, const size_t l ) const;
+    /**
+     * Near space propagation of the first count lanes, lane l to tsince[l]
+     */
+    static void PropagateLanes(
+        const NearSpaceLanes& lanes,
+        const double* tsince,
+        const size_t count,
+        Vector* positions,
+        Vector* velocities,
+        int* errors );
     Eci CalculateFinalPositionVelocity(
         const double tsince,
         const double e,
@@ -239,6 +394,7 @@ private:
      * Deep space secular effects
      */
     void DeepSpaceSecular(
+        struct IntegratorParams& params,
         const double tsince,
         double& xll,
         double& omgasm,
@@ -248,13 +404,17 @@ private:
         double& xn ) const;
     /**
      * Calculate dot terms
+     * @param[in] params the integrator state
      * @param[in,out] values the integrator values
      */
-    void DeepSpaceCalcDotTerms( struct IntegratorValues& values ) const;
+    void DeepSpaceCalcDotTerms(
+        const struct IntegratorParams& params,
+        struct IntegratorValues& values ) const;
     /**
      * Deep space integrator for time period of delt
      */
     void DeepSpaceIntegrator(
+        struct IntegratorParams& params,
         const double delt,
         const double step2,
         const struct IntegratorValues& values ) const;
@@ -267,7 +427,6 @@ private:
     struct NearSpaceConstants nearspace_consts_;
     struct DeepSpaceConstants deepspace_consts_;
     struct IntegratorConstants integrator_consts_;
-    mutable struct IntegratorParams integrator_params_;
 
     /*
      * the orbit data
@@ -280,6 +439,13 @@ private:
     bool use_simple_model_;
     bool use_deep_space_;
 
+    /*
+     * identifies the elements and constants of this propagator, renewed by
+     * every Initialise and shared only by copies, so a PropagationContext
+     * knows whether its checkpoint was made by the same orbit
+     */
+    uint64_t generation_;
+
     static const struct SGP4::CommonConstants Empty_CommonConstants;
     static const struct SGP4::NearSpaceConstants Empty_NearSpaceConstants;
     static const struct SGP4::DeepSpaceConstants Empty_DeepSpaceConstants;
@@ -287,6 +453,43 @@ private:
     static const struct SGP4::IntegratorParams Empty_IntegratorParams;
 };
 
+/**
+ * @brief Caller owned state of the deep space resonance integrator.
+ *
+ * Holds the integrator checkpoint of the last propagation, so the next one
+ * only integrates the difference. A context belongs to one thread, while
+ * the SGP4 object it is used with can be shared. The checkpoint is tagged
+ * with the generation of the propagator that made it, so using the context
+ * with another propagator, or after SetTle, restarts from epoch.
+ */
+class SGP4::PropagationContext
+{
+public:
+    PropagationContext()
+        : generation_( 0 )
+        , params_( SGP4::Empty_IntegratorParams )
+    {
+    }
+
+    /**
+     * Discard the checkpoint, the next propagation starts from epoch
+     */
+    void Reset()
+    {
+        generation_ = 0;
+    }
+
+private:
+    friend class SGP4;
+
+    /*
+     * the generation of the propagator the checkpoint was made with, zero
+     * for none
+     */
+    uint64_t generation_;
+    struct SGP4::IntegratorParams params_;
+};
+
 } //namespace SGP4
 
 #endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SATELLITEBATCH_H_
+#define SATELLITEBATCH_H_
+
+#include "SGP4.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief Propagates a whole catalog of satellites to a common date.
+ *
+ * The constants of near space satellites are stored lane by lane, so every
+ * block of SGP4 lanes is propagated together by the same kernel as
+ * SGP4::FindPositions. Deep space satellites are propagated one at a time.
+ * Results are identical to calling SGP4::FindPosition per satellite.
+ */
+class SGP4_DECL SatelliteBatch
+{
+public:
+    /**
+     * Outcome of propagating a satellite
+     */
+    enum class Status
+    {
+        /** position and velocity are valid */
+        Ok,
+        /** the elements or the propagation were invalid */
+        Failed,
+        /** the satellite has decayed, position and velocity are still set */
+        Decayed
+    };
+
+    /**
+     * Constructor. Satellites whose elements are rejected by SGP4 are kept
+     * and always report Status::Failed.
+     * @param[in] elements the elements of each satellite
+     */
+    explicit SatelliteBatch( const std::vector< OrbitalElements >& elements );
+
+    /**
+     * @returns the number of satellites
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Propagate every satellite to a date
+     * @param[in] dt the date to propagate to
+     * @param[out] positions Size() positions in kilometres
+     * @param[out] velocities Size() velocities in kilometres per second
+     * @param[out] statuses Size() statuses
+     */
+    void FindPositions( const DateTime& dt,
+                        Vector* positions,
+                        Vector* velocities,
+                        Status* statuses ) const;
+
+private:
+    size_t m_size;
+
+    /*
+     * near space satellites, kLanes to a block. the epoch and catalog index
+     * of each lane are stored in the same order
+     */
+    std::vector< SGP4::NearSpaceLanes > m_near_lanes;
+    std::vector< DateTime > m_near_epochs;
+    std::vector< size_t > m_near_index;
+
+    /*
+     * deep space satellites
+     */
+    std::vector< SGP4 > m_deep;
+    std::vector< size_t > m_deep_index;
+
+    /*
+     * satellites rejected when constructed
+     */
+    std::vector< size_t > m_failed_index;
+};
+
+} //namespace SGP4
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#ifndef STATIONNETWORK_H_
+#define STATIONNETWORK_H_
+
+#include "CoordGeodetic.h"
+#include "DateTime.h"
+#include "EarthOrientation.h"
+#include "Vector.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief The inertial positions of a fixed set of ground stations.
+ *
+ * Each station's earth fixed position, taking into account earth flattening
+ * as Eci::ToEci does, is computed once on construction and stored as arrays
+ * of coordinates. The positions at a date are then one rotation by the
+ * greenwich mean sidereal time applied to every station, a loop with no
+ * trigonometry that can be vectorised. Results agree with Eci::ToEci for each
+ * station to within rounding.
+ */
+class SGP4_DECL StationNetwork
+{
+public:
+    /**
+     * Constructor
+     * @param[in] stations the location of each station
+     */
+    explicit StationNetwork( const std::vector< CoordGeodetic >& stations );
+
+    /**
+     * @returns the number of stations
+     */
+    size_t Size() const
+    {
+        return m_x.size();
+    }
+
+    /**
+     * @param[in] i the index of a station
+     * @returns the earth fixed position of the station in kilometres
+     */
+    Vector EarthFixedPosition( const size_t i ) const
+    {
+        return Vector( m_x[i], m_y[i], m_z[i], m_radius[i] );
+    }
+
+    /**
+     * Find the position and velocity of every station at a date
+     * @param[in] dt the date
+     * @param[out] positions Size() positions in kilometres
+     * @param[out] velocities Size() velocities in kilometres per second
+     */
+    void FindPositions( const DateTime& dt,
+                        Vector* positions,
+                        Vector* velocities ) const
+    {
+        FindPositions( EarthOrientation( dt ), positions, velocities );
+    }
+
+    /**
+     * Find the position and velocity of every station at a date
+     * @param[in] orientation the earth orientation at the date
+     * @param[out] positions Size() positions in kilometres
+     * @param[out] velocities Size() velocities in kilometres per second
+     */
+    void FindPositions( const EarthOrientation& orientation,
+                        Vector* positions,
+                        Vector* velocities ) const;
+
+    /**
+     * Find the position and velocity of every station at a date, one array
+     * per coordinate
+     * @param[in] orientation the earth orientation at the date
+     * @param[out] x Size() x positions in kilometres
+     * @param[out] y Size() y positions in kilometres
+     * @param[out] z Size() z positions in kilometres
+     * @param[out] vx Size() x velocities in kilometres per second
+     * @param[out] vy Size() y velocities in kilometres per second
+     * @param[out] vz Size() z velocities in kilometres per second
+     */
+    void FindPositions( const EarthOrientation& orientation,
+                        double* x,
+                        double* y,
+                        double* z,
+                        double* vx,
+                        double* vy,
+                        double* vz ) const;
+
+private:
+    /*
+     * earth fixed position of each station, with the magnitudes of its
+     * position and velocity, which the rotation does not change
+     */
+    std::vector< double > m_x;
+    std::vector< double > m_y;
+    std::vector< double > m_z;
+    std::vector< double > m_radius;
+    std::vector< double > m_speed;
+};
+
+} //namespace SGP4
+
+#endif
@@ -21,6 +21,9 @@
 #include "Util.h"
 #include "DateTime.h"
 #include "TleException.h"
+#include "TleRecord.h"
+
+#include <cstddef>
 
 namespace SGP4 {
 
@@ -271,6 +274,24 @@ public:
         return TLE_LEN_LINE_DATA;
     }
 
+    /**
+     * Decode the fields of a tle without allocating. The name of the record
+     * is set to the norad number column of line one.
+     * @param[in] line_one Tle line one, need not be null terminated
+     * @param[in] line_one_length length of line one
+     * @param[in] line_two Tle line two, need not be null terminated
+     * @param[in] line_two_length length of line two
+     * @param[out] record the decoded fields
+     * @param[out] field the field that failed to decode
+     * @returns the reason the tle is invalid, or nullptr
+     */
+    static const char* Parse( const char* line_one,
+                              size_t line_one_length,
+                              const char* line_two,
+                              size_t line_two_length,
+                              TleRecord& record,
+                              const char*& field );
+
     /**
      * Dump this object to a string
      * @returns string
@@ -307,10 +328,6 @@ public:
 
 private:
     void Initialize();
-    static bool IsValidLineLength( const std::string& str );
-    void ExtractInteger( const std::string& str, unsigned int& val );
-    void ExtractDouble( const std::string& str, int point_pos, double& val );
-    void ExtractExponential( const std::string& str, double& val );
 
 private:
     std::string name_;
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TLECATALOG_H_
+#define TLECATALOG_H_
+
+#include "TleRecord.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief A record of a catalog that failed to decode.
+ */
+struct TleCatalogError
+{
+    /** line number, from 1, of the first line of the record */
+    size_t line;
+    /** the field that failed to decode */
+    const char* field;
+    /** the reason, one of the TleException messages */
+    const char* reason;
+};
+
+/**
+ * @brief Loads every record of a catalog file in parallel.
+ *
+ * The catalog is split into chunks on the record boundaries a serial read
+ * would find, and the chunks are decoded by a pool of threads with
+ * TleCatalogReader. Invalid records are
+ * listed in Errors() rather than thrown, and loading carries on past them.
+ * Records and errors keep the order of the file.
+ */
+class SGP4_DECL TleCatalog
+{
+public:
+    /**
+     * Constructor
+     * @param[in] filename the catalog file
+     * @param[in] threads the number of threads, 0 for one per core
+     * @exception TleException if the file cannot be read
+     */
+    explicit TleCatalog( const std::string& filename, unsigned int threads = 0 );
+
+    /**
+     * @returns the valid records
+     */
+    const std::vector< TleRecord >& Records() const
+    {
+        return m_records;
+    }
+
+    /**
+     * @returns the invalid records
+     */
+    const std::vector< TleCatalogError >& Errors() const
+    {
+        return m_errors;
+    }
+
+private:
+    void Load( const char* data, size_t size, unsigned int threads );
+
+    std::vector< TleRecord > m_records;
+    std::vector< TleCatalogError > m_errors;
+};
+
+} //namespace SGP4
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TLECATALOGREADER_H_
+#define TLECATALOGREADER_H_
+
+#include "MappedFile.h"
+#include "Tle.h"
+#include "TleRecord.h"
+
+#include <cstddef>
+#include <string>
+
+namespace SGP4 {
+
+/**
+ * @brief Reads the element sets of a catalog file one record at a time.
+ *
+ * The file is memory mapped and each record is decoded in place by
+ * Tle::Parse, so reading does not allocate. Records may be two line or
+ * three line element sets, mixed freely. Line endings may be LF or CRLF.
+ */
+class SGP4_DECL TleCatalogReader
+{
+public:
+    /**
+     * Constructor
+     * @param[in] filename the catalog file
+     * @exception TleException if the file cannot be read
+     */
+    explicit TleCatalogReader( const std::string& filename );
+
+    /**
+     * Constructor for a catalog already in memory
+     * @param[in] data the catalog text, which must outlive the reader
+     * @param[in] size the length of the text
+     */
+    TleCatalogReader( const char* data, size_t size );
+
+    /**
+     * Read the next record. On error the reader moves past the record, so
+     * reading can continue.
+     * @param[out] record the record
+     * @returns false at the end of the catalog
+     * @exception TleException if the record is invalid
+     */
+    bool Next( TleRecord& record );
+
+    /**
+     * Read the next record without throwing. On error the reader moves
+     * past the record, so reading can continue.
+     * @param[out] record the record, valid when reason is nullptr
+     * @param[out] field the field that failed to decode
+     * @param[out] reason the reason the record is invalid, or nullptr
+     * @returns false at the end of the catalog
+     */
+    bool Next( TleRecord& record, const char*& field, const char*& reason );
+
+    /**
+     * Move past the next record without decoding it. The lines are
+     * grouped into a record exactly as Next groups them.
+     * @returns false at the end of the catalog
+     */
+    bool Skip();
+
+    /**
+     * @returns the line number, from 1, of the first line of the last record
+     */
+    size_t LineNumber() const
+    {
+        return m_record_line;
+    }
+
+    /**
+     * @returns the offset in the catalog text of the line after the last
+     * record
+     */
+    size_t Position() const
+    {
+        return m_pos;
+    }
+
+    /**
+     * @returns the catalog text
+     */
+    const char* Data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @returns the length of the catalog text
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+private:
+    TleCatalogReader( const TleCatalogReader& );
+    TleCatalogReader& operator=( const TleCatalogReader& );
+
+    /*
+     * the lines of one record, name is nullptr for a two line record
+     */
+    struct Frame
+    {
+        const char* name;
+        size_t name_length;
+        const char* line_one;
+        size_t line_one_length;
+        const char* line_two;
+        size_t line_two_length;
+    };
+
+    bool NextLine( const char*& line, size_t& length );
+    bool NextFrame( Frame& frame, const char*& field, const char*& reason );
+
+    /*
+     * empty for a catalog already in memory
+     */
+    MappedFile m_file;
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    size_t m_line;
+    size_t m_record_line;
+};
+
+} //namespace SGP4
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TLERECORD_H_
+#define TLERECORD_H_
+
+#include "DateTime.h"
+
+namespace SGP4 {
+
+/**
+ * @brief The fields of a two-line element set without the text.
+ *
+ * A plain fixed size record, filled in by Tle::Parse and TleCatalogReader
+ * without any heap allocation. Angles are in degrees as in the tle.
+ */
+struct TleRecord
+{
+    /** satellite name, trailing spaces removed */
+    char name[25];
+    /** international designator, columns 10 to 17 of line one */
+    char int_designator[9];
+    unsigned int norad_number;
+    unsigned int orbit_number;
+    DateTime epoch;
+    double mean_motion_dt2;
+    double mean_motion_ddt6;
+    double bstar;
+    double inclination;
+    double right_ascending_node;
+    double eccentricity;
+    double argument_perigee;
+    double mean_anomaly;
+    /** revolutions per day */
+    double mean_motion;
+};
+
+} //namespace SGP4
+
+#endif
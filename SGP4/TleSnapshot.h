@@ -0,0 +1,114 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TLESNAPSHOT_H_
+#define TLESNAPSHOT_H_
+
+#include "MappedFile.h"
+#include "SGP4.h"
+#include "TleRecord.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief A binary snapshot of a catalog, loaded without decoding.
+ *
+ * The file holds the TleRecord of each satellite and optionally the SGP4
+ * constants derived from it, as arrays that are memory mapped and used in
+ * place. The layout is that of the writing build, so a snapshot is only
+ * loaded by a build with the same version, byte order and struct sizes.
+ */
+class SGP4_DECL TleSnapshot
+{
+public:
+    /**
+     * Write a snapshot
+     * @param[in] filename the file to write
+     * @param[in] records the records to store
+     * @param[in] with_constants whether to store the SGP4 constants as well
+     * @exception TleException if the file cannot be written
+     */
+    static void Write( const std::string& filename,
+                       const std::vector< TleRecord >& records,
+                       bool with_constants );
+
+    /**
+     * Constructor
+     * @param[in] filename the snapshot to load
+     * @exception TleException if the file is not a snapshot this build reads,
+     * or its arrays do not fit the file or hold flags that are not bools
+     */
+    explicit TleSnapshot( const std::string& filename );
+
+    /**
+     * @returns the number of records
+     */
+    size_t Size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * @returns the records, which live in the mapped file
+     */
+    const TleRecord* Records() const
+    {
+        return m_records;
+    }
+
+    /**
+     * @param[in] i the index of the record
+     * @returns the record
+     */
+    const TleRecord& Record( const size_t i ) const
+    {
+        return m_records[i];
+    }
+
+    /**
+     * @returns whether the SGP4 constants are stored
+     */
+    bool HasConstants() const
+    {
+        return m_states != nullptr;
+    }
+
+    /**
+     * Create the propagator of a record, from the stored constants when
+     * there are any
+     * @param[in] i the index of the record
+     * @returns the propagator
+     * @exception SatelliteException if the elements are invalid
+     */
+    SGP4 Propagator( size_t i ) const;
+
+private:
+    struct State;
+
+    MappedFile m_file;
+    size_t m_count;
+    const TleRecord* m_records;
+    const State* m_states;
+};
+
+} //namespace SGP4
+
+#endif
@@ -21,6 +21,8 @@
 #include "Decl.h"
 #include "Globals.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 namespace SGP4 {
@@ -103,6 +105,239 @@ inline double AcTan( const double sinx, const double cosx )
     }
 }
 
+/**
+ * Find a root of f by Brent's method
+ * @param[in] f the function
+ * @param[in] a one end of the bracket
+ * @param[in] fa f(a)
+ * @param[in] b the other end of the bracket, f(b) of opposite sign to f(a)
+ * @param[in] fb f(b)
+ * @param[in] tolerance the accuracy of the root
+ * @returns the root
+ */
+template
+<typename Function>
+double FindRoot( const Function& f,
+                 double a,
+                 double fa,
+                 double b,
+                 double fb,
+                 const double tolerance )
+{
+    double c = a;
+    double fc = fa;
+    double d = b - a;
+    double e = d;
+
+    for ( int iteration = 0; iteration < 64; ++iteration )
+    {
+        if ( ( fb > 0 ) == ( fc > 0 ) )
+        {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+
+        if ( fabs( fc ) < fabs( fb ) )
+        {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        const double tol = 2 * std::numeric_limits< double >::epsilon() * fabs( b )
+            + 0.5 * tolerance;
+        const double m = 0.5 * ( c - b );
+        if ( fabs( m ) <= tol || fb == 0 )
+        {
+            break;
+        }
+
+        if ( fabs( e ) >= tol && fabs( fa ) > fabs( fb ) )
+        {
+            /*
+             * secant or inverse quadratic interpolation
+             */
+            const double s = fb / fa;
+            double p;
+            double q;
+            if ( a == c )
+            {
+                p = 2 * m * s;
+                q = 1 - s;
+            }
+            else
+            {
+                const double r = fb / fc;
+                q = fa / fc;
+                p = s * ( 2 * m * q * ( q - r ) - ( b - a ) * ( r - 1 ) );
+                q = ( q - 1 ) * ( r - 1 ) * ( s - 1 );
+            }
+
+            if ( p > 0 )
+            {
+                q = -q;
+            }
+            else
+            {
+                p = -p;
+            }
+
+            if ( 2 * p < std::min( 3 * m * q - fabs( tol * q ), fabs( e * q ) ) )
+            {
+                e = d;
+                d = p / q;
+            }
+            else
+            {
+                d = e = m;
+            }
+        }
+        else
+        {
+            /*
+             * bisection
+             */
+            d = e = m;
+        }
+
+        a = b;
+        fa = fb;
+        b += fabs( d ) > tol ? d : ( m > 0 ? tol : -tol );
+        fb = f( b );
+    }
+
+    return b;
+}
+
+/**
+ * Find the maximum of f by Brent's method, parabolic interpolation
+ * falling back to golden section steps
+ * @param[in] f the function
+ * @param[in] a the lower end of the bracket
+ * @param[in] b the upper end of the bracket
+ * @param[in] x a point in [a, b] with f(x) no less than f(a) and f(b)
+ * @param[in] fx f(x)
+ * @param[in] tolerance the accuracy of the maximum
+ * @param[out] maximum f at the maximum
+ * @returns the point of the maximum
+ */
+template
+<typename Function>
+double FindMaximum( const Function& f,
+                    double a,
+                    double b,
+                    double x,
+                    double fx,
+                    const double tolerance,
+                    double& maximum )
+{
+    static const double kGoldenSection = 0.381966011250105152;
+
+    double w = x;
+    double v = x;
+    double fw = fx;
+    double fv = fx;
+    double d = 0.0;
+    double e = 0.0;
+
+    for ( int iteration = 0; iteration < 64; ++iteration )
+    {
+        const double xm = 0.5 * ( a + b );
+        const double tol = 2 * std::numeric_limits< double >::epsilon() * fabs( x )
+            + 0.5 * tolerance;
+        if ( fabs( x - xm ) <= 2 * tol - 0.5 * ( b - a ) )
+        {
+            break;
+        }
+
+        bool golden = true;
+        if ( fabs( e ) > tol )
+        {
+            /*
+             * vertex of the parabola through x, w and v
+             */
+            const double r = ( x - w ) * ( fx - fv );
+            double q = ( x - v ) * ( fx - fw );
+            double p = ( x - v ) * q - ( x - w ) * r;
+            q = 2 * ( q - r );
+            if ( q < 0 )
+            {
+                p = -p;
+            }
+            q = fabs( q );
+
+            if ( fabs( p ) < fabs( 0.5 * q * e ) && p > q * ( a - x ) && p < q * ( b - x ) )
+            {
+                e = d;
+                d = p / q;
+                golden = false;
+                const double u = x + d;
+                if ( u - a < 2 * tol || b - u < 2 * tol )
+                {
+                    d = xm > x ? tol : -tol;
+                }
+            }
+        }
+
+        if ( golden )
+        {
+            e = x >= xm ? a - x : b - x;
+            d = kGoldenSection * e;
+        }
+
+        const double u = fabs( d ) >= tol ? x + d : x + ( d > 0 ? tol : -tol );
+        const double fu = f( u );
+        if ( fu >= fx )
+        {
+            if ( u >= x )
+            {
+                a = x;
+            }
+            else
+            {
+                b = x;
+            }
+            v = w;
+            fv = fw;
+            w = x;
+            fw = fx;
+            x = u;
+            fx = fu;
+        }
+        else
+        {
+            if ( u < x )
+            {
+                a = u;
+            }
+            else
+            {
+                b = u;
+            }
+
+            if ( fu >= fw || w == x )
+            {
+                v = w;
+                fv = fw;
+                w = u;
+                fw = fu;
+            }
+            else if ( fu >= fv || v == x || v == w )
+            {
+                v = u;
+                fv = fu;
+            }
+        }
+    }
+
+    maximum = fx;
+    return x;
+}
+
 void SGP4_DECL TrimLeft( std::string& s );
 void SGP4_DECL TrimRight( std::string& s );
 void SGP4_DECL Trim( std::string& s );
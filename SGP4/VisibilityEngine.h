@@ -0,0 +1,120 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef VISIBILITYENGINE_H_
+#define VISIBILITYENGINE_H_
+
+#include "CoordGeodetic.h"
+#include "CoordTopocentric.h"
+#include "DateTime.h"
+#include "SatelliteBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace SGP4 {
+
+/**
+ * @brief A satellite in view of a station.
+ */
+struct Visibility
+{
+    /** index of the satellite */
+    size_t satellite;
+    /** index of the station */
+    size_t station;
+    /** the look angle from the station to the satellite */
+    CoordTopocentric look_angle;
+};
+
+/**
+ * @brief Finds which satellites of a catalog each station can see.
+ *
+ * Satellites are propagated together by a SatelliteBatch and rotated into
+ * the earth fixed frame with one GMST per date, where the geometry of every
+ * station is fixed. Stations are indexed by geocentric latitude and
+ * longitude cells, so each satellite is only tested against the stations
+ * under its footprint.
+ */
+class SGP4_DECL VisibilityEngine
+{
+public:
+    /**
+     * Constructor
+     * @param[in] satellites the elements of each satellite
+     * @param[in] stations the location of each station
+     * @param[in] min_elevation the elevation a satellite is visible from,
+     * in degrees
+     */
+    VisibilityEngine( const std::vector< OrbitalElements >& satellites,
+                      const std::vector< CoordGeodetic >& stations,
+                      double min_elevation );
+
+    /**
+     * Find the visible satellite and station pairs. Satellites that fail
+     * to propagate or have decayed are never visible.
+     * @param[in] dt the date
+     * @param[out] visible the pairs, grouped by satellite in index order
+     */
+    void FindVisible( const DateTime& dt, std::vector< Visibility >& visible );
+
+private:
+    void AddStations( size_t satellite,
+                      const Vector& position,
+                      const Vector& velocity,
+                      size_t cell_begin,
+                      size_t cell_end,
+                      std::vector< Visibility >& visible ) const;
+
+    SatelliteBatch m_batch;
+    double m_min_elevation;
+    double m_sin_min_elevation;
+    double m_cos_min_elevation;
+    /*
+     * the smallest geocentric radius of any station
+     */
+    double m_min_radius;
+
+    /*
+     * stations ordered by cell, with the index of each cell's first station
+     */
+    std::vector< size_t > m_cell_start;
+    std::vector< size_t > m_station_index;
+
+    /*
+     * earth fixed position of each station, its sine and cosine of latitude
+     * and longitude, in cell order
+     */
+    std::vector< double > m_x;
+    std::vector< double > m_y;
+    std::vector< double > m_z;
+    std::vector< double > m_sin_lat;
+    std::vector< double > m_cos_lat;
+    std::vector< double > m_sin_lon;
+    std::vector< double > m_cos_lon;
+
+    /*
+     * propagation results, kept between calls
+     */
+    std::vector< Vector > m_positions;
+    std::vector< Vector > m_velocities;
+    std::vector< SatelliteBatch::Status > m_statuses;
+};
+
+} //namespace SGP4
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/SatelliteBatch.h>
+
+#include <algorithm>
+
+namespace SGP4 {
+
+SatelliteBatch::SatelliteBatch( const std::vector< OrbitalElements >& elements )
+    : m_size( elements.size() )
+{
+    for ( size_t i = 0; i < elements.size(); i++ )
+    {
+        try
+        {
+            const SGP4 sgp4( elements[i] );
+
+            if ( sgp4.use_deep_space_ )
+            {
+                m_deep.push_back( sgp4 );
+                m_deep_index.push_back( i );
+                continue;
+            }
+
+            const size_t lane = m_near_index.size() % SGP4::kLanes;
+            if ( lane == 0 )
+            {
+                m_near_lanes.push_back( SGP4::NearSpaceLanes() );
+            }
+
+            /*
+             * unused lanes of the last block repeat this satellite, so
+             * they propagate without producing nonsense
+             */
+            for ( size_t l = lane; l < SGP4::kLanes; l++ )
+            {
+                sgp4.SetLane( m_near_lanes.back(), l );
+            }
+
+            m_near_epochs.push_back( elements[i].Epoch() );
+            m_near_index.push_back( i );
+        }
+        catch ( SatelliteException& )
+        {
+            m_failed_index.push_back( i );
+        }
+    }
+}
+
+void SatelliteBatch::FindPositions( const DateTime& dt,
+                                    Vector* positions,
+                                    Vector* velocities,
+                                    Status* statuses ) const
+{
+    double tsince[SGP4::kLanes];
+    Vector lane_positions[SGP4::kLanes];
+    Vector lane_velocities[SGP4::kLanes];
+    int errors[SGP4::kLanes];
+
+    for ( size_t block = 0; block < m_near_lanes.size(); block++ )
+    {
+        const size_t first = block * SGP4::kLanes;
+        const size_t lanes = std::min( SGP4::kLanes, m_near_index.size() - first );
+
+        for ( size_t l = 0; l < lanes; l++ )
+        {
+            tsince[l] = ( dt - m_near_epochs[first + l] ).TotalMinutes();
+        }
+
+        SGP4::PropagateLanes( m_near_lanes[block], tsince, lanes,
+                              lane_positions, lane_velocities, errors );
+
+        for ( size_t l = 0; l < lanes; l++ )
+        {
+            const size_t i = m_near_index[first + l];
+            positions[i] = lane_positions[l];
+            velocities[i] = lane_velocities[l];
+
+            switch ( errors[l] )
+            {
+            case SGP4::kLaneOk:
+                statuses[i] = Status::Ok;
+                break;
+            case SGP4::kLaneDecayed:
+                statuses[i] = Status::Decayed;
+                break;
+            default:
+                statuses[i] = Status::Failed;
+                break;
+            }
+        }
+    }
+
+    for ( size_t d = 0; d < m_deep.size(); d++ )
+    {
+        const size_t i = m_deep_index[d];
+        try
+        {
+            const Eci eci = m_deep[d].FindPosition( dt );
+            positions[i] = eci.Position();
+            velocities[i] = eci.Velocity();
+            statuses[i] = Status::Ok;
+        }
+        catch ( DecayedException& e )
+        {
+            positions[i] = e.Position();
+            velocities[i] = e.Velocity();
+            statuses[i] = Status::Decayed;
+        }
+        catch ( SatelliteException& )
+        {
+            positions[i] = Vector();
+            velocities[i] = Vector();
+            statuses[i] = Status::Failed;
+        }
+    }
+
+    for ( size_t f = 0; f < m_failed_index.size(); f++ )
+    {
+        const size_t i = m_failed_index[f];
+        positions[i] = Vector();
+        velocities[i] = Vector();
+        statuses[i] = Status::Failed;
+    }
+}
+
+} //namespace SGP4
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/SolarEphemerisTable.h>
+#include <SGP4/SolarPosition.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace SGP4 {
+
+SolarEphemerisTable::SolarEphemerisTable( const DateTime& start,
+                                          const DateTime& end,
+                                          const TimeSpan& step )
+    : m_start( start )
+    , m_end( end )
+    , m_step( step.Ticks() )
+{
+    if ( m_step <= 0 || end < start )
+    {
+        throw std::invalid_argument( "SolarEphemerisTable needs a positive step and end >= start" );
+    }
+
+    const int64_t intervals = ( end.Ticks() - start.Ticks() + m_step - 1 ) / m_step;
+    SolarPosition solar_position;
+
+    m_positions.reserve( static_cast< size_t >( intervals + 4 ) );
+    for ( int64_t i = -1; i <= intervals + 2; i++ )
+    {
+        m_positions.push_back( solar_position.FindPosition(
+            DateTime( start.Ticks() + i * m_step ) ).Position() );
+    }
+}
+
+Eci SolarEphemerisTable::FindPosition( const DateTime& dt ) const
+{
+    if ( dt < m_start || dt > m_end )
+    {
+        return SolarPosition().FindPosition( dt );
+    }
+
+    const int64_t offset = dt.Ticks() - m_start.Ticks();
+    const size_t i = static_cast< size_t >( offset / m_step ) + 1;
+    const double u = static_cast< double >( offset % m_step ) / m_step;
+
+    /*
+     * cubic hermite basis, with the tangents at each end of the interval
+     * taken from the central difference of the neighbouring samples
+     */
+    const double u2 = u * u;
+    const double u3 = u2 * u;
+    const double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+    const double h10 = 0.5 * ( u3 - 2.0 * u2 + u );
+    const double h01 = -2.0 * u3 + 3.0 * u2;
+    const double h11 = 0.5 * ( u3 - u2 );
+
+    const Vector& p0 = m_positions[ i - 1 ];
+    const Vector& p1 = m_positions[ i ];
+    const Vector& p2 = m_positions[ i + 1 ];
+    const Vector& p3 = m_positions[ i + 2 ];
+
+    Vector position( h00 * p1.x + h10 * ( p2.x - p0.x ) + h01 * p2.x + h11 * ( p3.x - p1.x ),
+                     h00 * p1.y + h10 * ( p2.y - p0.y ) + h01 * p2.y + h11 * ( p3.y - p1.y ),
+                     h00 * p1.z + h10 * ( p2.z - p0.z ) + h01 * p2.z + h11 * ( p3.z - p1.z ) );
+    position.w = position.Magnitude();
+
+    return Eci( dt, position );
+}
+
+} //namespace SGP4
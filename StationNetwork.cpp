@@ -0,0 +1,92 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <SGP4/StationNetwork.h>
+#include <SGP4/Eci.h>
+#include <SGP4/Globals.h>
+
+#include <cmath>
+
+namespace SGP4 {
+
+StationNetwork::StationNetwork( const std::vector< CoordGeodetic >& stations )
+    : m_x( stations.size() )
+    , m_y( stations.size() )
+    , m_z( stations.size() )
+    , m_radius( stations.size() )
+    , m_speed( stations.size() )
+{
+    for ( size_t i = 0; i < stations.size(); i++ )
+    {
+        const CoordGeodetic& geo = stations[i];
+        double achcp;
+        Eci::EarthFixedDistances( geo, achcp, m_z[i] );
+
+        m_x[i] = achcp * cos( geo.longitude );
+        m_y[i] = achcp * sin( geo.longitude );
+        m_radius[i] = sqrt( m_x[i] * m_x[i] + m_y[i] * m_y[i] + m_z[i] * m_z[i] );
+        m_speed[i] = kEARTH_ROTATION * fabs( achcp );
+    }
+}
+
+void StationNetwork::FindPositions( const EarthOrientation& orientation,
+                                    Vector* positions,
+                                    Vector* velocities ) const
+{
+    const double sin_gmst = orientation.SinGmst();
+    const double cos_gmst = orientation.CosGmst();
+
+    for ( size_t i = 0; i < m_x.size(); i++ )
+    {
+        const double x = cos_gmst * m_x[i] - sin_gmst * m_y[i];
+        const double y = sin_gmst * m_x[i] + cos_gmst * m_y[i];
+
+        positions[i] = Vector( x, y, m_z[i], m_radius[i] );
+        velocities[i] = Vector( -kEARTH_ROTATION * y, kEARTH_ROTATION * x, 0.0, m_speed[i] );
+    }
+}
+
+void StationNetwork::FindPositions( const EarthOrientation& orientation,
+                                    double* x,
+                                    double* y,
+                                    double* z,
+                                    double* vx,
+                                    double* vy,
+                                    double* vz ) const
+{
+    const double sin_gmst = orientation.SinGmst();
+    const double cos_gmst = orientation.CosGmst();
+    const double* ex = m_x.data();
+    const double* ey = m_y.data();
+    const double* ez = m_z.data();
+
+    for ( size_t i = 0; i < m_x.size(); i++ )
+    {
+        const double px = cos_gmst * ex[i] - sin_gmst * ey[i];
+        const double py = sin_gmst * ex[i] + cos_gmst * ey[i];
+
+        x[i] = px;
+        y[i] = py;
+        z[i] = ez[i];
+        vx[i] = -kEARTH_ROTATION * py;
+        vy[i] = kEARTH_ROTATION * px;
+        vz[i] = 0.0;
+    }
+}
+
+} //namespace SGP4
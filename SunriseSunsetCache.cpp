@@ -0,0 +1,142 @@
+#include "SunriseSunsetCache.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <SGP4/Util.h>
+using namespace SGP4;
+namespace
+{
+  // Thresholds are keyed to a millionth of a degree.
+  const double thresholdScale = 1e6;
+  std::uint64_t mix(std::uint64_t h)
+  {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+  }
+}
+bool SunriseSunsetCache::Key::operator==(const Key &other) const
+{
+  return day == other.day && latitude == other.latitude && longitude == other.longitude &&
+         altitude == other.altitude && threshold == other.threshold;
+}
+std::uint64_t SunriseSunsetCache::hashKey(const Key &key)
+{
+  std::uint64_t h = mix(static_cast< std::uint64_t >(key.day));
+  h = mix(h ^ static_cast< std::uint64_t >(key.latitude));
+  h = mix(h ^ static_cast< std::uint64_t >(key.longitude));
+  h = mix(h ^ static_cast< std::uint64_t >(key.altitude));
+  h = mix(h ^ static_cast< std::uint64_t >(key.threshold));
+  return h;
+}
+std::size_t SunriseSunsetCache::KeyHash::operator()(const Key &key) const
+{
+  return static_cast< std::size_t >(hashKey(key));
+}
+SunriseSunsetCache::SunriseSunsetCache(const SunriseSunsetCacheOptions &options):
+  m_options(options)
+{
+  if (!(options.gridDegrees > 0.0) || !(options.altitudeStep > 0.0) || options.capacity == 0 || options.shards == 0)
+  {
+    throw std::invalid_argument("SunriseSunsetCache needs a positive grid, altitude step, capacity and shard count");
+  }
+  const std::size_t shards = std::min(options.shards, options.capacity);
+  m_shards.reserve(shards);
+  for (std::size_t i = 0; i < shards; ++i)
+  {
+    m_shards.emplace_back(new Shard());
+    m_shards.back()->capacity = options.capacity / shards + (i < options.capacity % shards ? 1 : 0);
+  }
+}
+SunriseSunsetCache::Key SunriseSunsetCache::makeKey(const DateTime &date, const Observer &observer,
+                                                    double threshold) const
+{
+  const CoordGeodetic &location = observer.GetLocation();
+  Key key;
+  key.day = date.Ticks() / TicksPerDay;
+  key.latitude = std::llround(Util::RadiansToDegrees(location.latitude) / m_options.gridDegrees);
+  key.longitude =
+    std::llround(Util::WrapNegPos180(Util::RadiansToDegrees(location.longitude)) / m_options.gridDegrees);
+  // +180 and -180 are one meridian, so a cell centred on it takes the key of its west side.
+  const std::int64_t antimeridian = std::llround(180.0 / m_options.gridDegrees);
+  if (key.longitude == antimeridian && std::fabs(antimeridian * m_options.gridDegrees - 180.0) < 1e-9)
+  {
+    key.longitude = -antimeridian;
+  }
+  key.altitude = std::llround(location.altitude / m_options.altitudeStep);
+  key.threshold = std::llround(threshold * thresholdScale);
+  return key;
+}
+// The search at the centre of the key's cell, so a cached result does not depend on which request in the
+// cell filled it.
+SunriseSunsetResult SunriseSunsetCache::compute(const Key &key) const
+{
+  double latitude = std::max(-90.0, std::min(90.0, key.latitude * m_options.gridDegrees));
+  Observer observer(latitude, key.longitude * m_options.gridDegrees, key.altitude * m_options.altitudeStep);
+  DateTime date(key.day * TicksPerDay);
+  if (key.threshold == 0)
+  {
+    return getSunriseSunset(date, observer, m_options.method);
+  }
+  SolarEvent event = getSolarEvents(date, observer, std::vector< double >(1, key.threshold / thresholdScale)).front();
+  return SunriseSunsetResult{event.rising, event.setting, event.status};
+}
+SunriseSunsetResult SunriseSunsetCache::get(const DateTime &date, const Observer &observer, double threshold)
+{
+  Key key = makeKey(date, observer, threshold);
+  // The shard comes from the high half of the hash, as the maps inside a shard index by its low bits.
+  std::uint64_t hash = hashKey(key);
+  Shard &shard = *m_shards[static_cast< std::size_t >((hash >> 32) % m_shards.size())];
+  {
+    std::lock_guard< std::mutex > lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found != shard.index.end())
+    {
+      shard.hits++;
+      shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+      return found->second->second;
+    }
+    shard.misses++;
+  }
+  SunriseSunsetResult result = compute(key);
+  std::lock_guard< std::mutex > lock(shard.mutex);
+  // Another thread may have filled the same key while the search ran.
+  if (shard.index.find(key) != shard.index.end())
+  {
+    return result;
+  }
+  shard.entries.emplace_front(key, result);
+  shard.index.emplace(key, shard.entries.begin());
+  if (shard.entries.size() > shard.capacity)
+  {
+    shard.index.erase(shard.entries.back().first);
+    shard.entries.pop_back();
+  }
+  return result;
+}
+SunriseSunsetCacheStats SunriseSunsetCache::stats() const
+{
+  SunriseSunsetCacheStats stats{0, 0, 0};
+  for (const auto &shard : m_shards)
+  {
+    std::lock_guard< std::mutex > lock(shard->mutex);
+    stats.hits += shard->hits;
+    stats.misses += shard->misses;
+    stats.size += shard->entries.size();
+  }
+  return stats;
+}
+void SunriseSunsetCache::clear()
+{
+  for (const auto &shard : m_shards)
+  {
+    std::lock_guard< std::mutex > lock(shard->mutex);
+    shard->entries.clear();
+    shard->index.clear();
+    shard->hits = 0;
+    shard->misses = 0;
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef SUNRISESUNSETCACHE_H
+#define SUNRISESUNSETCACHE_H
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "SunriseSunsetTime.h"
+// How a SunriseSunsetCache quantizes its keys and how much it holds. Locations are snapped to the centre of
+// a gridDegrees cell in latitude and longitude and altitudes to a multiple of altitudeStep (km) before the
+// search, so every request in a cell shares one result; sunrise moves by about 4 s per 0.01 degree of
+// longitude, more in latitude near the polar circles. capacity entries are split over shards, the
+// remainder going one each to the first shards so the total is exactly capacity, and each shard evicts
+// its least recently used entry when full. There are at most capacity shards.
+struct SunriseSunsetCacheOptions
+{
+  double gridDegrees = 0.01;
+  double altitudeStep = 0.1;
+  std::size_t capacity = 65536;
+  std::size_t shards = 16;
+  SunriseSunsetMethod method = SunriseSunsetMethod::HourAngle;
+};
+struct SunriseSunsetCacheStats
+{
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::size_t size;
+};
+// A bounded, thread-safe memo of getSunriseSunset results keyed by UTC day, quantized location and
+// elevation threshold (degrees). Threshold 0 is the sunrise of getSunriseSunset; other thresholds come
+// from getSolarEvents. Lookups lock only the shard their key hashes to, and a miss runs the search
+// without holding the lock.
+class SunriseSunsetCache
+{
+public:
+  explicit SunriseSunsetCache(const SunriseSunsetCacheOptions &options = SunriseSunsetCacheOptions());
+  SunriseSunsetResult get(const SGP4::DateTime &date, const SGP4::Observer &observer, double threshold = 0.0);
+  SunriseSunsetCacheStats stats() const;
+  void clear();
+
+private:
+  struct Key
+  {
+    std::int64_t day;
+    std::int64_t latitude;
+    std::int64_t longitude;
+    std::int64_t altitude;
+    std::int64_t threshold;
+    bool operator==(const Key &other) const;
+  };
+  struct KeyHash
+  {
+    std::size_t operator()(const Key &key) const;
+  };
+  struct Shard
+  {
+    std::mutex mutex;
+    std::list< std::pair< Key, SunriseSunsetResult > > entries;
+    std::unordered_map< Key, std::list< std::pair< Key, SunriseSunsetResult > >::iterator, KeyHash > index;
+    std::size_t capacity = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+  };
+  static std::uint64_t hashKey(const Key &key);
+  Key makeKey(const SGP4::DateTime &date, const SGP4::Observer &observer, double threshold) const;
+  SunriseSunsetResult compute(const Key &key) const;
+
+  SunriseSunsetCacheOptions m_options;
+  std::vector< std::unique_ptr< Shard > > m_shards;
+};
+#endif
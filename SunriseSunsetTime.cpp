@@ -1,63 +1,899 @@
 #include "SunriseSunsetTime.h"
-#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 #include <SGP4/CoordTopocentric.h>
+#include <SGP4/EarthOrientation.h>
+#include <SGP4/Eci.h>
+#include <SGP4/Globals.h>
+#include <SGP4/SolarEphemerisTable.h>
 #include <SGP4/SolarPosition.h>
 using namespace SGP4;
 namespace
 {
   int sunCriticalAngle = 0;
-  double getSunElevation(const DateTime &currTime, Observer observer)
+  // The Sun's elevation never changes faster than Earth's rotation relative to it (~15 deg/h),
+  // so a sample |e| degrees away from the horizon cannot cross it within |e| / maxElevationRate hours.
+  // Steps are at least minScanStep, so samples near a threshold are checked for a crossing and a return
+  // hidden between them.
+  const double maxElevationRate = 15.5;
+  const int64_t minScanStep = 20 * TicksPerMinute;
+  const int64_t maxScanStep = 3 * TicksPerHour;
+  // Crossings are refined to a tenth of the millisecond the results are rounded to.
+  const double crossingTolerance = 1e-4;
+  // Transit and anti-transit are refined to a hundredth of a second, as the elevation is flat around them.
+  const double extremumTolerance = 1e-2;
+  // Spacing of the shared solar track used by the batch search.
+  const int64_t sunTrackStep = 10 * TicksPerMinute;
+  // Half-widths of the bracket around a crossing seeded from the previous day alone, or extrapolated from
+  // the previous two days. Events drift by minutes per day, but the drift itself changes by seconds.
+  const int64_t coldWindow = 15 * TicksPerMinute;
+  const int64_t warmWindow = 2 * TicksPerMinute;
+  // Allowance in degrees for the Sun's parallax and its declination peaking inside a day at a solstice,
+  // when classifying a day from the declination at either end of it.
+  const double declinationMargin = 0.05;
+  // Rate of the mean Sun's hour angle in radians per second.
+  const double solarHourRate = kTWOPI / 86400.0;
+  // The hour angle fast path is left to the scan where the Sun meets the horizon within 15 degrees of hour
+  // angle of the meridian, as the horizon is then nearly tangent to its path.
+  const double maxCosHourAngle = 0.966;
+  const int maxHourAngleIterations = 4;
+  // Bounds on how far an event moves from one day to the next, from the change of the Sun's declination
+  // (radians) and the equation of time over a day. An event closer than that to the end of the day may
+  // have been preceded by one of the same kind just after its start, which only the scan finds.
+  const double maxDeclinationChange = 0.0072;
+  const int64_t maxEquationOfTimeChange = 30 * TicksPerSecond;
+  double getSunElevation(const DateTime &currTime, const Observer &observer)
   {
     Eci sunEci = SolarPosition().FindPosition(currTime);
     CoordTopocentric lookAngle = observer.GetLookAngle(sunEci);
     return Util::RadiansToDegrees(lookAngle.elevation);
   }
+  double getSunElevation(const DateTime &currTime, const Observer &observer, const SolarEphemerisTable &table)
+  {
+    CoordTopocentric lookAngle = observer.GetLookAngle(table.FindPosition(currTime));
+    return Util::RadiansToDegrees(lookAngle.elevation);
+  }
   DateTime roundToMilliseconds(const DateTime &dateTime)
   {
     int64_t milliseconds = (dateTime.Ticks() / TicksPerMillisecond) * TicksPerMillisecond;
     return DateTime{milliseconds};
   }
-  DateTime binarySearch(const DateTime &currTime, const std::function< bool(DateTime) > &exitCondition)
+  // Scan step from a sample distance degrees away from the nearest threshold.
+  int64_t nextScanStep(double distance)
+  {
+    auto step = static_cast< int64_t >(std::fabs(distance) / maxElevationRate * TicksPerHour);
+    return std::min(std::max(step, minScanStep), maxScanStep);
+  }
+  // Refines the root of horizonValueAt, which changes sign over [lower, upper], to crossingTolerance.
+  template < typename HorizonFunction >
+  DateTime refineCrossing(const DateTime &lower, double lowerValue, const DateTime &upper, double upperValue,
+                          const HorizonFunction &horizonValueAt)
+  {
+    auto offsetValue = [&lower, &horizonValueAt](double seconds)
+    {
+      return horizonValueAt(DateTime(lower.Ticks() + static_cast< int64_t >(std::llround(seconds * TicksPerSecond))));
+    };
+    double span = static_cast< double >(upper.Ticks() - lower.Ticks()) / TicksPerSecond;
+    double seconds = Util::FindRoot(offsetValue, 0.0, lowerValue, span, upperValue, crossingTolerance);
+    return DateTime(lower.Ticks() + static_cast< int64_t >(std::llround(seconds * TicksPerSecond)));
+  }
+  // Refines the highest point of valueAt over [lower, upper], starting from middle, the highest sample in it.
+  template < typename ValueFunction >
+  DateTime refineMaximum(const DateTime &lower, const DateTime &middle, double middleValue, const DateTime &upper,
+                         const ValueFunction &valueAt, double &maximum)
+  {
+    auto offsetValue = [&lower, &valueAt](double seconds)
+    {
+      return valueAt(DateTime(lower.Ticks() + static_cast< int64_t >(std::llround(seconds * TicksPerSecond))));
+    };
+    double span = static_cast< double >(upper.Ticks() - lower.Ticks()) / TicksPerSecond;
+    double offset = static_cast< double >(middle.Ticks() - lower.Ticks()) / TicksPerSecond;
+    double seconds = Util::FindMaximum(offsetValue, 0.0, span, offset, middleValue, extremumTolerance, maximum);
+    return DateTime(lower.Ticks() + static_cast< int64_t >(std::llround(seconds * TicksPerSecond)));
+  }
+  // Finds a crossing and a return hidden between two samples on the same side of the threshold, from horizon
+  // values that are the sine of the elevation less that of the threshold. The sine changes by at most the
+  // rate of the hour angle times the step, and bends from the chord between the samples by at most that
+  // rate squared times the step squared over eight, so the Sun can only get across when both allow it.
+  // A step holds at most one extremum of the elevation, so refining it then decides. Returns false if the
+  // Sun stays on one side, else the crossings in time order.
+  template < typename HorizonFunction >
+  bool findExcursion(const DateTime &lower, double lowerValue, const DateTime &upper, double upperValue,
+                     const HorizonFunction &horizonValueAt, DateTime &first, DateTime &second)
+  {
+    double sign = lowerValue > 0 ? -1.0 : 1.0;
+    double change = Util::DegreesToRadians(maxElevationRate) * static_cast< double >(upper.Ticks() - lower.Ticks())
+                    / TicksPerHour;
+    if ((lowerValue > 0) != (upperValue > 0) || std::fabs(lowerValue) + std::fabs(upperValue) > change
+        || std::max(sign * lowerValue, sign * upperValue) + change * change / 8 <= 0)
+    {
+      return false;
+    }
+    auto valueAt = [&horizonValueAt, sign](const DateTime &dt)
+    {
+      return sign * horizonValueAt(dt);
+    };
+    bool lowerCloser = sign * lowerValue >= sign * upperValue;
+    double peakValue;
+    DateTime peak = refineMaximum(lower, lowerCloser ? lower : upper, sign * (lowerCloser ? lowerValue : upperValue),
+                                  upper, valueAt, peakValue);
+    if (peakValue <= 0)
+    {
+      return false;
+    }
+    first = refineCrossing(lower, lowerValue, peak, sign * peakValue, horizonValueAt);
+    second = refineCrossing(peak, sign * peakValue, upper, upperValue, horizonValueAt);
+    return true;
+  }
+  // One sample of the Sun's elevation curve.
+  struct ElevationSample
+  {
+    DateTime time;
+    double elevation;
+  };
+  // Status of a day given which crossings were found and, if none was, whether the Sun stayed up.
+  SunriseSunsetStatus classifyDay(bool sunriseFound, bool sunsetFound, bool sunAbove)
+  {
+    if (sunriseFound && sunsetFound)
+    {
+      return SunriseSunsetStatus::Normal;
+    }
+    if (sunriseFound)
+    {
+      return SunriseSunsetStatus::OnlySunrise;
+    }
+    if (sunsetFound)
+    {
+      return SunriseSunsetStatus::OnlySunset;
+    }
+    return sunAbove ? SunriseSunsetStatus::PolarDay : SunriseSunsetStatus::PolarNight;
+  }
+  // The Sun's declination over a day in radians, from its position at either end of the day in any frame
+  // sharing Earth's axis.
+  struct DeclinationRange
+  {
+    double lowest;
+    double highest;
+  };
+  DeclinationRange getDeclinationRange(const Vector &sunAtStart, const Vector &sunAtEnd)
+  {
+    double start = asin(sunAtStart.z / sunAtStart.Magnitude());
+    double end = asin(sunAtEnd.z / sunAtEnd.Magnitude());
+    return DeclinationRange{std::min(start, end), std::max(start, end)};
+  }
+  // Classifies a day in O(1) when the Sun cannot cross threshold at latitude (radians). The Sun culminates
+  // at 90 degrees less the angle between the latitude and its declination, and is lowest at the angle
+  // between the opposite latitude and its declination less 90 degrees. Returns false when the day needs a
+  // search.
+  bool classifyByDeclination(const DeclinationRange &declination, double latitude, double threshold,
+                             SunriseSunsetStatus &status)
+  {
+    auto distance = [&declination](double angle)
+    {
+      return std::max(0.0, std::max(declination.lowest - angle, angle - declination.highest));
+    };
+    double highest = 90.0 - Util::RadiansToDegrees(distance(latitude));
+    double lowest = Util::RadiansToDegrees(distance(-latitude)) - 90.0;
+    if (highest < threshold - declinationMargin)
+    {
+      status = SunriseSunsetStatus::PolarNight;
+      return true;
+    }
+    if (lowest > threshold + declinationMargin)
+    {
+      status = SunriseSunsetStatus::PolarDay;
+      return true;
+    }
+    return false;
+  }
+  // Scans the day from dayStart with steps no sample can skip a crossing of any threshold with, or that
+  // findExcursion checks, then refines the first rising and the first setting crossing of each threshold
+  // from the samples bracketing it. Crossings not found are left as DateTime(), which no crossing can fall
+  // on. With samples the scan covers the whole day rather than stopping at the last crossing, and keeps
+  // every sample it takes.
+  template < typename ElevationFunction >
+  void findCrossings(const DateTime &dayStart, const ElevationFunction &elevationAt, const double *thresholds,
+                     std::size_t count, SolarEvent *events, std::vector< ElevationSample > *samples = nullptr)
+  {
+    DateTime dayEnd(dayStart.Ticks() + TicksPerDay - 1);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      events[i].elevation = thresholds[i];
+      events[i].rising = DateTime();
+      events[i].setting = DateTime();
+    }
+    std::size_t remaining = 2 * count;
+    DateTime lower = dayStart;
+    double lowerElevation = elevationAt(lower);
+    if (samples)
+    {
+      samples->push_back(ElevationSample{lower, lowerElevation});
+    }
+    while (lower < dayEnd && (remaining > 0 || samples))
+    {
+      double distance = std::fabs(lowerElevation - thresholds[0]);
+      for (std::size_t i = 1; i < count; ++i)
+      {
+        distance = std::min(distance, std::fabs(lowerElevation - thresholds[i]));
+      }
+      DateTime upper(std::min(lower.Ticks() + nextScanStep(distance), dayEnd.Ticks()));
+      double upperElevation = elevationAt(upper);
+      if (samples)
+      {
+        samples->push_back(ElevationSample{upper, upperElevation});
+      }
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        double threshold = thresholds[i];
+        auto horizonValueAt = [&elevationAt, threshold](const DateTime &dt)
+        {
+          return elevationAt(dt) - threshold;
+        };
+        bool lowerAbove = lowerElevation > threshold;
+        bool upperAbove = upperElevation > threshold;
+        if (!lowerAbove && upperAbove && events[i].rising == DateTime())
+        {
+          events[i].rising = refineCrossing(lower, lowerElevation - threshold, upper, upperElevation - threshold,
+                                            horizonValueAt);
+          remaining--;
+        }
+        else if (lowerAbove && !upperAbove && events[i].setting == DateTime())
+        {
+          events[i].setting = refineCrossing(lower, lowerElevation - threshold, upper, upperElevation - threshold,
+                                             horizonValueAt);
+          remaining--;
+        }
+        else if (lowerAbove == upperAbove && (events[i].rising == DateTime() || events[i].setting == DateTime()))
+        {
+          double sinThreshold = sin(Util::DegreesToRadians(threshold));
+          auto sineValueAt = [&elevationAt, sinThreshold](const DateTime &dt)
+          {
+            return sin(Util::DegreesToRadians(elevationAt(dt))) - sinThreshold;
+          };
+          DateTime first;
+          DateTime second;
+          if (findExcursion(lower, sin(Util::DegreesToRadians(lowerElevation)) - sinThreshold, upper,
+                            sin(Util::DegreesToRadians(upperElevation)) - sinThreshold, sineValueAt, first, second))
+          {
+            DateTime &rising = events[i].rising;
+            DateTime &setting = events[i].setting;
+            if (rising == DateTime())
+            {
+              rising = lowerAbove ? second : first;
+              remaining--;
+            }
+            if (setting == DateTime())
+            {
+              setting = lowerAbove ? first : second;
+              remaining--;
+            }
+          }
+        }
+      }
+      lower = upper;
+      lowerElevation = upperElevation;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      events[i].status = classifyDay(events[i].rising != DateTime(), events[i].setting != DateTime(),
+                                     lowerElevation > thresholds[i]);
+    }
+  }
+  // Sunrise and sunset at sunCriticalAngle alone.
+  template < typename ElevationFunction >
+  SunriseSunsetStatus findCrossings(const DateTime &dayStart, const ElevationFunction &elevationAt, DateTime &sunrise,
+                                    DateTime &sunset)
+  {
+    const double threshold = sunCriticalAngle;
+    SolarEvent event;
+    findCrossings(dayStart, elevationAt, &threshold, 1, &event);
+    sunrise = event.rising;
+    sunset = event.setting;
+    return event.status;
+  }
+  // The highest peak of sign times the elevation over a day scanned into samples, or the higher end of the
+  // day when it has no peak. It is refined around the highest sample above both its neighbours or, when
+  // no sample is, over the first and the last interval of the day, where a peak just inside the day has
+  // no sample on its outer side.
+  template < typename ElevationFunction >
+  DateTime findExtremum(const std::vector< ElevationSample > &samples, double sign,
+                        const ElevationFunction &elevationAt, double &elevation)
+  {
+    auto valueAt = [&elevationAt, sign](const DateTime &dt)
+    {
+      return sign * elevationAt(dt);
+    };
+    auto sampleValue = [&samples, sign](std::size_t i)
+    {
+      return sign * samples[i].elevation;
+    };
+    std::size_t last = samples.size() - 1;
+    std::size_t peak = 0;
+    for (std::size_t i = 1; i < last; ++i)
+    {
+      if (sampleValue(i) >= sampleValue(i - 1) && sampleValue(i) >= sampleValue(i + 1)
+          && (peak == 0 || sampleValue(i) > sampleValue(peak)))
+      {
+        peak = i;
+      }
+    }
+    double value;
+    DateTime time;
+    if (peak != 0)
+    {
+      time = refineMaximum(samples[peak - 1].time, samples[peak].time, sampleValue(peak), samples[peak + 1].time,
+                           valueAt, value);
+    }
+    else
+    {
+      std::size_t start = sampleValue(0) >= sampleValue(1) ? 0 : 1;
+      time = refineMaximum(samples[0].time, samples[start].time, sampleValue(start), samples[1].time, valueAt,
+                           value);
+      std::size_t end = sampleValue(last) >= sampleValue(last - 1) ? last : last - 1;
+      double endValue;
+      DateTime endTime = refineMaximum(samples[last - 1].time, samples[end].time, sampleValue(end),
+                                       samples[last].time, valueAt, endValue);
+      // A refinement that stays on the edge of the day found no peak there.
+      const int64_t edge = static_cast< int64_t >(2 * extremumTolerance * TicksPerSecond);
+      bool startPeak = time.Ticks() - samples[0].time.Ticks() > edge;
+      bool endPeak = samples[last].time.Ticks() - endTime.Ticks() > edge;
+      if (startPeak != endPeak ? endPeak : endValue > value)
+      {
+        time = endTime;
+        value = endValue;
+      }
+    }
+    elevation = sign * value;
+    return time;
+  }
+  // Ticks the Sun spends above threshold over a day scanned into samples, from every crossing between them
+  // rather than the first rising and setting alone, as near the polar circles the Sun can rise, set and rise
+  // again in one day. Crossings known already, the first of event, are not refined again. The samples end a
+  // tick before the day does, and that tick is on the side of the last sample.
+  template < typename ElevationFunction >
+  int64_t findTimeAbove(const std::vector< ElevationSample > &samples, const ElevationFunction &elevationAt,
+                        const SolarEvent &event)
+  {
+    const double threshold = event.elevation;
+    auto horizonValueAt = [&elevationAt, threshold](const DateTime &dt)
+    {
+      return elevationAt(dt) - threshold;
+    };
+    double sinThreshold = sin(Util::DegreesToRadians(threshold));
+    auto sineValueAt = [&elevationAt, sinThreshold](const DateTime &dt)
+    {
+      return sin(Util::DegreesToRadians(elevationAt(dt))) - sinThreshold;
+    };
+    int64_t above = samples.back().elevation > threshold ? 1 : 0;
+    for (std::size_t i = 1; i < samples.size(); ++i)
+    {
+      const ElevationSample &lower = samples[i - 1];
+      const ElevationSample &upper = samples[i];
+      bool lowerAbove = lower.elevation > threshold;
+      bool upperAbove = upper.elevation > threshold;
+      if (lowerAbove != upperAbove)
+      {
+        DateTime crossing = upperAbove ? event.rising : event.setting;
+        if (!(lower.time < crossing && crossing <= upper.time))
+        {
+          crossing = refineCrossing(lower.time, lower.elevation - threshold, upper.time, upper.elevation - threshold,
+                                    horizonValueAt);
+        }
+        above += upperAbove ? upper.time.Ticks() - crossing.Ticks() : crossing.Ticks() - lower.time.Ticks();
+        continue;
+      }
+      DateTime first;
+      DateTime second;
+      int64_t excursion = 0;
+      if (findExcursion(lower.time, sin(Util::DegreesToRadians(lower.elevation)) - sinThreshold, upper.time,
+                        sin(Util::DegreesToRadians(upper.elevation)) - sinThreshold, sineValueAt, first, second))
+      {
+        excursion = second.Ticks() - first.Ticks();
+      }
+      above += lowerAbove ? upper.time.Ticks() - lower.time.Ticks() - excursion : excursion;
+    }
+    return above;
+  }
+  // The Sun seen from the observer at one time, with its hour angle and declination in radians.
+  struct SunSample
+  {
+    double elevation;
+    double hourAngle;
+    double declination;
+  };
+  SunSample sampleSun(const DateTime &dt, const Observer &observer)
+  {
+    Eci sun = SolarPosition().FindPosition(dt);
+    EarthOrientation orientation(dt);
+    Vector position = sun.Position();
+    SunSample sample;
+    sample.elevation = observer.GetLookAngle(sun, orientation).elevation;
+    sample.hourAngle = Util::WrapNegPosPI(orientation.LocalMeanSiderealTime(observer.GetLocation().longitude)
+                                          - atan2(position.y, position.x));
+    sample.declination = asin(position.z / position.Magnitude());
+    return sample;
+  }
+  // Converges on the crossing of sunCriticalAngle nearest guess by Newton's method on the Sun's elevation,
+  // with its rate of change taken from the hour angle. Returns false unless it converges on a crossing of
+  // the given direction inside the day and more than edge before its end.
+  bool refineHourAngle(DateTime guess, bool rising, const Observer &observer, const DateTime &dayStart,
+                       const DateTime &dayEnd, int64_t edge, DateTime &crossing)
   {
-    int year = currTime.Year();
-    int month = currTime.Month();
-    int day = currTime.Day();
-    DateTime dayStart(year, month, day, 0, 0, 0, 0);
-    DateTime dayEnd(year, month, day, 23, 59, 59, 999999);
-    DateTime lowerBound = dayStart;
-    DateTime upperBound = dayEnd;
-    DateTime result = dayStart;
-    while (lowerBound <= upperBound)
+    double cosLat = cos(observer.GetLocation().latitude);
+    double threshold = Util::DegreesToRadians(sunCriticalAngle);
+    for (int iteration = 0; iteration < maxHourAngleIterations; ++iteration)
     {
-      DateTime mid = DateTime(lowerBound.Ticks() + (upperBound.Ticks() - lowerBound.Ticks()) / 2);
-      if (exitCondition(mid))
+      SunSample sun = sampleSun(guess, observer);
+      double rate = -cosLat * cos(sun.declination) * sin(sun.hourAngle) * solarHourRate / cos(sun.elevation);
+      if ((rate > 0) != rising)
       {
-        result = mid;
-        upperBound = mid - TimeSpan(1);
+        return false;
       }
-      else
+      double step = (threshold - sun.elevation) / rate;
+      guess = DateTime(guess.Ticks() + static_cast< int64_t >(std::llround(step * TicksPerSecond)));
+      if (std::fabs(step) < crossingTolerance)
+      {
+        crossing = guess;
+        return guess >= dayStart && dayEnd.Ticks() - guess.Ticks() > edge;
+      }
+    }
+    return false;
+  }
+  // Sunrise and sunset from the hour angle at which the Sun meets the horizon, cos H = (sin h0 - sin lat
+  // sin dec) / (cos lat cos dec), with the declination and hour angle of one solar position at the mean
+  // solar noon inside the day. Each event is then corrected by refineHourAngle. Returns false when the day
+  // needs the scan.
+  bool solveHourAngle(const DateTime &dayStart, const Observer &observer, SunriseSunsetResult &result)
+  {
+    double latitude = observer.GetLocation().latitude;
+    int64_t noonOffset = TicksPerDay / 2
+                         - static_cast< int64_t >(observer.GetLocation().longitude / solarHourRate * TicksPerSecond)
+                         - dayStart.Ticks() % TicksPerDay;
+    DateTime noon(dayStart.Ticks() + (noonOffset % TicksPerDay + TicksPerDay) % TicksPerDay);
+    SunSample sun = sampleSun(noon, observer);
+    double cosHourAngle = (sin(Util::DegreesToRadians(sunCriticalAngle)) - sin(latitude) * sin(sun.declination))
+                          / (cos(latitude) * cos(sun.declination));
+    if (std::fabs(cosHourAngle) > maxCosHourAngle)
+    {
+      return false;
+    }
+    double hourAngle = acos(cosHourAngle);
+    DateTime dayEnd(dayStart.Ticks() + TicksPerDay - 1);
+    // d(hour angle) / d(declination) is at most tan(lat) / sin(hour angle) away from the poles
+    double drift = std::fabs(tan(latitude)) * maxDeclinationChange / sin(hourAngle) / solarHourRate;
+    int64_t edge = static_cast< int64_t >(drift * TicksPerSecond) + maxEquationOfTimeChange;
+    auto guessAt = [&noon, &sun, &dayStart, &dayEnd](double targetHourAngle)
+    {
+      double seconds = Util::WrapNegPosPI(targetHourAngle - sun.hourAngle) / solarHourRate;
+      int64_t ticks = noon.Ticks() + static_cast< int64_t >(std::llround(seconds * TicksPerSecond));
+      if (ticks < dayStart.Ticks())
+      {
+        ticks += TicksPerDay;
+      }
+      else if (ticks > dayEnd.Ticks())
+      {
+        ticks -= TicksPerDay;
+      }
+      return DateTime(ticks);
+    };
+    if (!refineHourAngle(guessAt(-hourAngle), true, observer, dayStart, dayEnd, edge, result.sunrise)
+        || !refineHourAngle(guessAt(hourAngle), false, observer, dayStart, dayEnd, edge, result.sunset))
+    {
+      return false;
+    }
+    result.status = SunriseSunsetStatus::Normal;
+    result.sunrise = roundToMilliseconds(result.sunrise);
+    result.sunset = roundToMilliseconds(result.sunset);
+    return true;
+  }
+  // Sunrise and sunset on the UTC day starting at dayStart, rounded, with days the Sun cannot rise or set
+  // on classified from its position at either end of the day before any search.
+  template < typename ElevationFunction >
+  SunriseSunsetResult solveDay(const DateTime &dayStart, const Observer &observer, const ElevationFunction &elevationAt,
+                               const Vector &sunAtStart, const Vector &sunAtEnd)
+  {
+    SunriseSunsetResult result;
+    if (!classifyByDeclination(getDeclinationRange(sunAtStart, sunAtEnd), observer.GetLocation().latitude,
+                               sunCriticalAngle, result.status))
+    {
+      result.status = findCrossings(dayStart, elevationAt, result.sunrise, result.sunset);
+      result.sunrise = roundToMilliseconds(result.sunrise);
+      result.sunset = roundToMilliseconds(result.sunset);
+    }
+    return result;
+  }
+  // Refines a crossing expected near guess, for searches seeded from a neighbouring day. Returns false
+  // if [guess - window, guess + window] leaves the day or does not bracket a crossing of that direction.
+  template < typename HorizonFunction >
+  bool refineNear(const DateTime &guess, int64_t window, bool rising, const DateTime &dayStart,
+                  const DateTime &dayEnd, const HorizonFunction &horizonValueAt, DateTime &crossing)
+  {
+    DateTime lower(guess.Ticks() - window);
+    DateTime upper(guess.Ticks() + window);
+    if (lower < dayStart || upper > dayEnd)
+    {
+      return false;
+    }
+    double lowerValue = horizonValueAt(lower);
+    double upperValue = horizonValueAt(upper);
+    if ((lowerValue > 0) == rising || (upperValue > 0) != rising)
+    {
+      return false;
+    }
+    crossing = refineCrossing(lower, lowerValue, upper, upperValue, horizonValueAt);
+    return true;
+  }
+  // Next day's crossing guessed from the last two days' crossings, or from the last one alone.
+  DateTime extrapolateCrossing(const DateTime &last, const DateTime &beforeLast, bool haveBeforeLast)
+  {
+    int64_t drift = haveBeforeLast ? (last.Ticks() - beforeLast.Ticks()) - TicksPerDay : 0;
+    return DateTime(last.Ticks() + TicksPerDay + drift);
+  }
+  // The Sun's position over a UTC day, taken from a table sampled once at sunTrackStep and expressed
+  // in the Earth-fixed frame so sites need no sidereal time of their own.
+  class SunTrack
+  {
+  public:
+    explicit SunTrack(const DateTime &dayStart)
+      : m_start(dayStart)
+      , m_table(dayStart, DateTime(dayStart.Ticks() + TicksPerDay), TimeSpan(sunTrackStep))
+    {
+    }
+    std::size_t Size() const
+    {
+      return static_cast< std::size_t >(TicksPerDay / sunTrackStep) + 1;
+    }
+    DateTime TimeAt(std::size_t index) const
+    {
+      return DateTime(m_start.Ticks() + static_cast< int64_t >(index) * sunTrackStep);
+    }
+    Vector EarthFixedAt(std::size_t index) const
+    {
+      return EarthFixedAt(TimeAt(index));
+    }
+    Vector EarthFixedAt(const DateTime &dt) const
+    {
+      return EarthOrientation(dt).ToEarthFixed(m_table.FindPosition(dt).Position());
+    }
+  private:
+    DateTime m_start;
+    SolarEphemerisTable m_table;
+  };
+  // Earth-fixed position and local vertical of each site, stored as parallel arrays.
+  struct SiteGeometry
+  {
+    explicit SiteGeometry(const CoordGeodetic *sites, std::size_t count)
+      : x(count), y(count), z(count), upX(count), upY(count), upZ(count)
+    {
+      for (std::size_t i = 0; i < count; ++i)
       {
-        lowerBound = mid + TimeSpan(1);
+        double sinLat = sin(sites[i].latitude);
+        double cosLat = cos(sites[i].latitude);
+        double sinLon = sin(sites[i].longitude);
+        double cosLon = cos(sites[i].longitude);
+        double achcp;
+        Eci::EarthFixedDistances(sites[i], achcp, z[i]);
+        x[i] = achcp * cosLon;
+        y[i] = achcp * sinLon;
+        upX[i] = cosLat * cosLon;
+        upY[i] = cosLat * sinLon;
+        upZ[i] = sinLat;
       }
     }
+    // Sine of the Sun's elevation above the critical angle, which has the same sign as the elevation difference.
+    double HorizonValue(std::size_t i, const Vector &sun, double sinCriticalAngle) const
+    {
+      double rangeX = sun.x - x[i];
+      double rangeY = sun.y - y[i];
+      double rangeZ = sun.z - z[i];
+      double range = sqrt(rangeX * rangeX + rangeY * rangeY + rangeZ * rangeZ);
+      return (upX[i] * rangeX + upY[i] * rangeY + upZ[i] * rangeZ) / range - sinCriticalAngle;
+    }
+    std::vector< double > x;
+    std::vector< double > y;
+    std::vector< double > z;
+    std::vector< double > upX;
+    std::vector< double > upY;
+    std::vector< double > upZ;
+  };
+}
+LocalDay getLocalDay(const DateTime &date, const TimeSpan &utcOffset)
+{
+  DateTime localMidnight(date.Year(), date.Month(), date.Day(), 0, 0, 0, 0);
+  return LocalDay{DateTime(localMidnight.Ticks() - utcOffset.Ticks())};
+}
+LocalDay getLocalDay(const DateTime &date, const Observer &observer)
+{
+  return getLocalDay(date, TimeSpan(std::llround(observer.GetLocation().longitude / solarHourRate * TicksPerSecond)));
+}
+SunriseSunsetResult getSunriseSunset(const DateTime &date, const Observer &observer, SunriseSunsetMethod method)
+{
+  return getSunriseSunset(getLocalDay(date, TimeSpan(0)), observer, method);
+}
+SunriseSunsetResult getSunriseSunset(const LocalDay &day, const Observer &observer, SunriseSunsetMethod method)
+{
+  auto elevationAt = [&observer](const DateTime &dt)
+  {
+    return getSunElevation(dt, observer);
+  };
+  const DateTime &dayStart = day.start;
+  SunriseSunsetResult result;
+  if (method == SunriseSunsetMethod::HourAngle && solveHourAngle(dayStart, observer, result))
+  {
     return result;
   }
+  SolarPosition solarPosition;
+  return solveDay(dayStart, observer, elevationAt, solarPosition.FindPosition(dayStart).Position(),
+                  solarPosition.FindPosition(dayStart.AddTicks(TicksPerDay)).Position());
 }
 std::pair< DateTime, DateTime > getSunriseAndSunsetTime(const DateTime &currTime, const Observer &observer)
 {
-  DateTime sunrise = binarySearch(currTime, [&observer](DateTime dt)
+  SunriseSunsetResult result = getSunriseSunset(currTime, observer);
+  if (result.status != SunriseSunsetStatus::Normal)
   {
-    double midSunElevation = getSunElevation(dt, observer);
-    return midSunElevation > sunCriticalAngle;
-  });
-  DateTime sunset = binarySearch(currTime, [&observer](DateTime dt)
+    throw std::runtime_error("Polar day or polar night. No sunrise/sunset found.");
+  }
+  return std::make_pair(result.sunrise, result.sunset);
+}
+std::pair< DateTime, DateTime > getSunriseAndSunsetTime(const DateTime &currTime, const Observer &observer,
+                                                        const SolarEphemerisTable &table)
+{
+  auto elevationAt = [&observer, &table](const DateTime &dt)
   {
-    double midSunElevation = getSunElevation(dt, observer);
-    return midSunElevation <= sunCriticalAngle;
-  });
-  if (sunrise == currTime || sunset == currTime)
+    return getSunElevation(dt, observer, table);
+  };
+  DateTime dayStart(currTime.Year(), currTime.Month(), currTime.Day(), 0, 0, 0, 0);
+  SunriseSunsetResult result = solveDay(dayStart, observer, elevationAt, table.FindPosition(dayStart).Position(),
+                                        table.FindPosition(dayStart.AddTicks(TicksPerDay)).Position());
+  if (result.status != SunriseSunsetStatus::Normal)
   {
     throw std::runtime_error("Polar day or polar night. No sunrise/sunset found.");
   }
-  return std::make_pair(roundToMilliseconds(sunrise), roundToMilliseconds(sunset));
+  return std::make_pair(result.sunrise, result.sunset);
+}
+void getSunriseAndSunsetTimeBatch(const DateTime &date, const CoordGeodetic *sites, std::size_t count,
+                                  DateTime *sunrises, DateTime *sunsets, SunriseSunsetStatus *statuses)
+{
+  DateTime dayStart(date.Year(), date.Month(), date.Day(), 0, 0, 0, 0);
+  SunTrack sunTrack(dayStart);
+  // Sites the Sun cannot rise or set at are classified up front, the rest are searched.
+  DeclinationRange declination = getDeclinationRange(sunTrack.EarthFixedAt(0),
+                                                     sunTrack.EarthFixedAt(sunTrack.Size() - 1));
+  std::vector< CoordGeodetic > searched;
+  std::vector< std::size_t > searchedIndex;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    sunrises[i] = DateTime();
+    sunsets[i] = DateTime();
+    if (!classifyByDeclination(declination, sites[i].latitude, sunCriticalAngle, statuses[i]))
+    {
+      searched.push_back(sites[i]);
+      searchedIndex.push_back(i);
+    }
+  }
+  count = searched.size();
+  SiteGeometry geometry(searched.data(), count);
+  double sinCriticalAngle = sin(Util::DegreesToRadians(sunCriticalAngle));
+  auto horizonValueAt = [&sunTrack, &geometry, sinCriticalAngle](std::size_t i, const DateTime &dt)
+  {
+    return geometry.HorizonValue(i, sunTrack.EarthFixedAt(dt), sinCriticalAngle);
+  };
+  // Brackets are sample indices, or hidden for crossings findExcursion has already refined.
+  const std::size_t noBracket = sunTrack.Size();
+  const std::size_t hidden = noBracket + 1;
+  std::vector< double > previous(count);
+  std::vector< double > current(count);
+  std::vector< std::size_t > sunriseBracket(count, noBracket);
+  std::vector< std::size_t > sunsetBracket(count, noBracket);
+  std::vector< double > sunriseValues(2 * count);
+  std::vector< double > sunsetValues(2 * count);
+  Vector sun = sunTrack.EarthFixedAt(0);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    previous[i] = geometry.HorizonValue(i, sun, sinCriticalAngle);
+  }
+  for (std::size_t sample = 1; sample < sunTrack.Size(); ++sample)
+  {
+    sun = sunTrack.EarthFixedAt(sample);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      current[i] = geometry.HorizonValue(i, sun, sinCriticalAngle);
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      bool previousAbove = previous[i] > 0;
+      bool currentAbove = current[i] > 0;
+      if (!previousAbove && currentAbove && sunriseBracket[i] == noBracket)
+      {
+        sunriseBracket[i] = sample - 1;
+        sunriseValues[2 * i] = previous[i];
+        sunriseValues[2 * i + 1] = current[i];
+      }
+      else if (previousAbove && !currentAbove && sunsetBracket[i] == noBracket)
+      {
+        sunsetBracket[i] = sample - 1;
+        sunsetValues[2 * i] = previous[i];
+        sunsetValues[2 * i + 1] = current[i];
+      }
+      else if (previousAbove == currentAbove && (sunriseBracket[i] == noBracket || sunsetBracket[i] == noBracket))
+      {
+        auto siteValueAt = [&horizonValueAt, i](const DateTime &dt)
+        {
+          return horizonValueAt(i, dt);
+        };
+        DateTime first;
+        DateTime second;
+        if (findExcursion(sunTrack.TimeAt(sample - 1), previous[i], sunTrack.TimeAt(sample), current[i], siteValueAt,
+                          first, second))
+        {
+          std::size_t site = searchedIndex[i];
+          if (sunriseBracket[i] == noBracket)
+          {
+            sunriseBracket[i] = hidden;
+            sunrises[site] = roundToMilliseconds(previousAbove ? second : first);
+          }
+          if (sunsetBracket[i] == noBracket)
+          {
+            sunsetBracket[i] = hidden;
+            sunsets[site] = roundToMilliseconds(previousAbove ? first : second);
+          }
+        }
+      }
+    }
+    previous.swap(current);
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto siteValueAt = [&horizonValueAt, i](const DateTime &dt)
+    {
+      return horizonValueAt(i, dt);
+    };
+    bool sunriseFound = sunriseBracket[i] != noBracket;
+    bool sunsetFound = sunsetBracket[i] != noBracket;
+    std::size_t site = searchedIndex[i];
+    if (sunriseFound && sunriseBracket[i] != hidden)
+    {
+      std::size_t sample = sunriseBracket[i];
+      sunrises[site] = roundToMilliseconds(refineCrossing(sunTrack.TimeAt(sample), sunriseValues[2 * i],
+                                                       sunTrack.TimeAt(sample + 1), sunriseValues[2 * i + 1],
+                                                       siteValueAt));
+    }
+    if (sunsetFound && sunsetBracket[i] != hidden)
+    {
+      std::size_t sample = sunsetBracket[i];
+      sunsets[site] = roundToMilliseconds(refineCrossing(sunTrack.TimeAt(sample), sunsetValues[2 * i],
+                                                      sunTrack.TimeAt(sample + 1), sunsetValues[2 * i + 1],
+                                                      siteValueAt));
+    }
+    statuses[site] = classifyDay(sunriseFound, sunsetFound, previous[i] > 0);
+  }
+}
+std::vector< SolarEvent > getSolarEvents(const DateTime &date, const Observer &observer,
+                                         const std::vector< double > &thresholds)
+{
+  return getSolarEvents(getLocalDay(date, TimeSpan(0)), observer, thresholds);
+}
+std::vector< SolarEvent > getSolarEvents(const LocalDay &day, const Observer &observer,
+                                         const std::vector< double > &thresholds)
+{
+  auto elevationAt = [&observer](const DateTime &dt)
+  {
+    return getSunElevation(dt, observer);
+  };
+  std::vector< SolarEvent > events(thresholds.size());
+  if (thresholds.empty())
+  {
+    return events;
+  }
+  findCrossings(day.start, elevationAt, thresholds.data(), thresholds.size(), events.data());
+  for (auto &event : events)
+  {
+    event.rising = roundToMilliseconds(event.rising);
+    event.setting = roundToMilliseconds(event.setting);
+  }
+  return events;
+}
+SolarDay getSolarDay(const DateTime &date, const Observer &observer, const std::vector< double > &thresholds)
+{
+  return getSolarDay(getLocalDay(date, TimeSpan(0)), observer, thresholds);
+}
+SolarDay getSolarDay(const LocalDay &day, const Observer &observer, const std::vector< double > &thresholds)
+{
+  auto elevationAt = [&observer](const DateTime &dt)
+  {
+    return getSunElevation(dt, observer);
+  };
+  // Sunrise and sunset first, then the caller's thresholds, all from one scan.
+  std::vector< double > allThresholds(1, sunriseElevation);
+  allThresholds.insert(allThresholds.end(), thresholds.begin(), thresholds.end());
+  std::vector< SolarEvent > events(allThresholds.size());
+  std::vector< ElevationSample > samples;
+  findCrossings(day.start, elevationAt, allThresholds.data(), allThresholds.size(), events.data(), &samples);
+  // Time above the horizon, which can run across midnight and be split by the Sun setting and rising again.
+  int64_t dayLength = findTimeAbove(samples, elevationAt, events.front());
+  for (auto &event : events)
+  {
+    event.rising = roundToMilliseconds(event.rising);
+    event.setting = roundToMilliseconds(event.setting);
+  }
+  double transitElevation;
+  DateTime transit = findExtremum(samples, 1.0, elevationAt, transitElevation);
+  double antiTransitElevation;
+  DateTime antiTransit = findExtremum(samples, -1.0, elevationAt, antiTransitElevation);
+  const SolarEvent &sunrise = events.front();
+  return SolarDay{sunrise,
+                  roundToMilliseconds(transit),
+                  transitElevation,
+                  roundToMilliseconds(antiTransit),
+                  antiTransitElevation,
+                  TimeSpan(dayLength),
+                  std::vector< SolarEvent >(events.begin() + 1, events.end())};
+}
+std::vector< SunriseSunsetResult > getSunriseSunsetCalendar(const Observer &observer, const DateTime &firstDate,
+                                                            const DateTime &lastDate)
+{
+  auto elevationAt = [&observer](const DateTime &dt)
+  {
+    return getSunElevation(dt, observer);
+  };
+  auto horizonValueAt = [&observer](const DateTime &dt)
+  {
+    return getSunElevation(dt, observer) - sunCriticalAngle;
+  };
+  DateTime firstDay(firstDate.Year(), firstDate.Month(), firstDate.Day(), 0, 0, 0, 0);
+  DateTime lastDay(lastDate.Year(), lastDate.Month(), lastDate.Day(), 0, 0, 0, 0);
+  std::vector< SunriseSunsetResult > calendar;
+  if (lastDay < firstDay)
+  {
+    return calendar;
+  }
+  calendar.reserve(static_cast< std::size_t >((lastDay.Ticks() - firstDay.Ticks()) / TicksPerDay) + 1);
+  // Days that follow one that was not normal are first classified from the Sun's declination, so runs
+  // of polar days are found without a search.
+  SolarPosition solarPosition;
+  auto classifyFromDeclination = [&observer, &solarPosition](const DateTime &dayStart, const DateTime &dayEnd,
+                                                            SunriseSunsetStatus &status)
+  {
+    return classifyByDeclination(getDeclinationRange(solarPosition.FindPosition(dayStart).Position(),
+                                                     solarPosition.FindPosition(dayEnd).Position()),
+                                 observer.GetLocation().latitude, sunCriticalAngle, status);
+  };
+  // Number of consecutive previous normal days, capped at the two used to extrapolate the events.
+  int history = 0;
+  for (DateTime dayStart = firstDay; dayStart <= lastDay; dayStart = dayStart.AddTicks(TicksPerDay))
+  {
+    DateTime dayEnd(dayStart.Ticks() + TicksPerDay - 1);
+    SunriseSunsetResult result;
+    bool sunriseFound = false;
+    bool sunsetFound = false;
+    if (history > 0)
+    {
+      const SunriseSunsetResult &last = calendar.back();
+      const SunriseSunsetResult &beforeLast = calendar[calendar.size() - history];
+      int64_t window = history > 1 ? warmWindow : coldWindow;
+      sunriseFound = refineNear(extrapolateCrossing(last.sunrise, beforeLast.sunrise, history > 1), window, true,
+                                dayStart, dayEnd, horizonValueAt, result.sunrise);
+      sunsetFound = sunriseFound && refineNear(extrapolateCrossing(last.sunset, beforeLast.sunset, history > 1),
+                                               window, false, dayStart, dayEnd, horizonValueAt, result.sunset);
+    }
+    if (sunriseFound && sunsetFound)
+    {
+      result.status = SunriseSunsetStatus::Normal;
+    }
+    else if (history > 0 || !classifyFromDeclination(dayStart, dayEnd, result.status))
+    {
+      result.status = findCrossings(dayStart, elevationAt, result.sunrise, result.sunset);
+    }
+    history = result.status == SunriseSunsetStatus::Normal ? std::min(history + 1, 2) : 0;
+    calendar.push_back(result);
+  }
+  // Seeds come from unrounded times, so only round once every day is solved.
+  for (auto &result : calendar)
+  {
+    result.sunrise = roundToMilliseconds(result.sunrise);
+    result.sunset = roundToMilliseconds(result.sunset);
+  }
+  return calendar;
 }
@@ -1,8 +1,115 @@
 #ifndef SUNRISESUNSETTIME_H
 #define SUNRISESUNSETTIME_H
+#include <cstddef>
 #include <utility>
+#include <vector>
+#include <SGP4/CoordGeodetic.h>
 #include <SGP4/DateTime.h>
 #include <SGP4/Observer.h>
+#include <SGP4/SolarEphemerisTable.h>
+enum class SunriseSunsetStatus
+{
+  Normal,
+  PolarDay,
+  PolarNight,
+  OnlySunrise,
+  OnlySunset
+};
+struct SunriseSunsetResult
+{
+  SGP4::DateTime sunrise;
+  SGP4::DateTime sunset;
+  SunriseSunsetStatus status;
+};
+// Elevations of the Sun's centre in degrees that mark the usual solar events. Sunrise and sunset allow
+// for atmospheric refraction and the Sun's semi-diameter. Golden hour is while the Sun is between
+// blueHourElevation and goldenHourElevation, blue hour while it is between civilTwilightElevation and
+// blueHourElevation.
+const double sunriseElevation = -0.833;
+const double civilTwilightElevation = -6.0;
+const double nauticalTwilightElevation = -12.0;
+const double astronomicalTwilightElevation = -18.0;
+const double goldenHourElevation = 6.0;
+const double blueHourElevation = -4.0;
+// The Sun crossing one elevation threshold. status uses OnlySunrise and OnlySunset for days with only
+// the rising or only the setting crossing, PolarDay and PolarNight for the Sun staying above or below.
+struct SolarEvent
+{
+  double elevation;
+  SGP4::DateTime rising;
+  SGP4::DateTime setting;
+  SunriseSunsetStatus status;
+};
+// A summary of the Sun over a UTC or local day. transit and antiTransit are the Sun's upper and lower culmination
+// during the day, with its elevation then in degrees; when the day holds more than one, the higher or
+// lower of them. A day with no culmination inside it, as can happen near 180 degrees of longitude,
+// gives whichever end of the day the Sun is higher or lower at.
+// dayLength is the time the Sun spends above sunriseElevation during the day.
+struct SolarDay
+{
+  SolarEvent sunrise;
+  SGP4::DateTime transit;
+  double transitElevation;
+  SGP4::DateTime antiTransit;
+  double antiTransitElevation;
+  SGP4::TimeSpan dayLength;
+  std::vector< SolarEvent > events;
+};
+// The 24 hours from a local midnight, in UTC, for the searches to cover in place of the UTC day of a date,
+// so that one search gives the rise and set of a local day.
+struct LocalDay
+{
+  SGP4::DateTime start;
+};
+// The local day on the calendar date of date, at utcOffset from UTC as for a time zone.
+LocalDay getLocalDay(const SGP4::DateTime &date, const SGP4::TimeSpan &utcOffset);
+// The local day on the calendar date of date in the observer's local mean time, an hour from UTC for each
+// 15 degrees of longitude.
+LocalDay getLocalDay(const SGP4::DateTime &date, const SGP4::Observer &observer);
+// How getSunriseSunset finds the events. Scan brackets them by sampling the Sun's elevation over the day.
+// HourAngle seeds each from the closed-form hour angle of the Sun at the horizon and corrects it by Newton
+// steps on the elevation, a handful of solar positions in all, and falls back to Scan near polar
+// conditions or for events within minutes of the start or end of the day.
+enum class SunriseSunsetMethod
+{
+  Scan,
+  HourAngle
+};
+// Sunrise and sunset on the UTC day of date or on day, with the status of the day rather than an exception when the
+// Sun does not both rise and set. Days the Sun cannot reach the horizon on at the observer's latitude are
+// classified from its declination before any search. Times missing for the status are left as DateTime().
+SunriseSunsetResult getSunriseSunset(const SGP4::DateTime &date, const SGP4::Observer &observer,
+                                     SunriseSunsetMethod method = SunriseSunsetMethod::Scan);
+SunriseSunsetResult getSunriseSunset(const LocalDay &day, const SGP4::Observer &observer,
+                                     SunriseSunsetMethod method = SunriseSunsetMethod::Scan);
+// As getSunriseSunset, throwing std::runtime_error unless the day is normal.
 std::pair< SGP4::DateTime, SGP4::DateTime >
 getSunriseAndSunsetTime(const SGP4::DateTime &currTime, const SGP4::Observer &observer);
+// Same search with the Sun's position interpolated from table, for callers that already hold one.
+std::pair< SGP4::DateTime, SGP4::DateTime >
+getSunriseAndSunsetTime(const SGP4::DateTime &currTime, const SGP4::Observer &observer,
+                        const SGP4::SolarEphemerisTable &table);
+// Sunrise and sunset on the UTC day of date for count sites. The Sun's track for the day is computed
+// once and shared by all sites; times missing for a site's status are left as DateTime().
+void getSunriseAndSunsetTimeBatch(const SGP4::DateTime &date, const SGP4::CoordGeodetic *sites, std::size_t count,
+                                  SGP4::DateTime *sunrises, SGP4::DateTime *sunsets, SunriseSunsetStatus *statuses);
+// The first rising and setting crossing of each elevation threshold (degrees) on the UTC day of date or on day,
+// in the order of thresholds. The elevation curve is sampled once for all thresholds; times missing for
+// an event's status are left as DateTime().
+std::vector< SolarEvent > getSolarEvents(const SGP4::DateTime &date, const SGP4::Observer &observer,
+                                         const std::vector< double > &thresholds);
+std::vector< SolarEvent > getSolarEvents(const LocalDay &day, const SGP4::Observer &observer,
+                                         const std::vector< double > &thresholds);
+// Sunrise, sunset, transit, anti-transit and day length on the UTC day of date or on day, with the crossings of
+// thresholds in events. Comes from the same single scan as getSolarEvents, run over the whole day, with
+// the extrema refined by parabolic interpolation from the samples bracketing them.
+SolarDay getSolarDay(const SGP4::DateTime &date, const SGP4::Observer &observer,
+                     const std::vector< double > &thresholds = std::vector< double >());
+SolarDay getSolarDay(const LocalDay &day, const SGP4::Observer &observer,
+                     const std::vector< double > &thresholds = std::vector< double >());
+// One result per UTC day from firstDate to lastDate inclusive. Each day's search is seeded from the
+// previous days' events and falls back to a full-day search when the seed does not bracket them.
+std::vector< SunriseSunsetResult > getSunriseSunsetCalendar(const SGP4::Observer &observer,
+                                                            const SGP4::DateTime &firstDate,
+                                                            const SGP4::DateTime &lastDate);
 #endif
@@ -17,7 +17,7 @@
 
 #include <SGP4/Tle.h>
 
-#include <locale> 
+#include <cstring>
 
 namespace SGP4 {
 
@@ -63,309 +63,397 @@ static const unsigned int TLE2_COL_REVATEPOCH = 63;
 static const unsigned int TLE2_LEN_REVATEPOCH = 5;
 }
 
-/**
- * Initialise the tle object.
- * @exception TleException
- */
-void Tle::Initialize()
-{
-    if ( !IsValidLineLength( line_one_ ) )
-    {
-        throw TleException( "Invalid length for line one" );
-    }
-
-    if ( !IsValidLineLength( line_two_ ) )
-    {
-        throw TleException( "Invalid length for line two" );
-    }
-
-    if ( line_one_[ 0 ] != '1' )
-    {
-        throw TleException( "Invalid line beginning for line one" );
-    }
-
-    if ( line_two_[ 0 ] != '2' )
-    {
-        throw TleException( "Invalid line beginning for line two" );
-    }
-
-    unsigned int sat_number_1;
-    unsigned int sat_number_2;
+namespace {
+static const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-    ExtractInteger( line_one_.substr( TLE1_COL_NORADNUM,
-                    TLE1_LEN_NORADNUM ), sat_number_1 );
-    ExtractInteger( line_two_.substr( TLE2_COL_NORADNUM,
-                    TLE2_LEN_NORADNUM ), sat_number_2 );
+bool IsDigit( const char c )
+{
+    return c >= '0' && c <= '9';
+}
 
-    if ( sat_number_1 != sat_number_2 )
+/*
+ * a mantissa of at most 15 digits and a power of ten up to 1e22 are exact
+ * doubles, so one multiplication or division rounds the value the same
+ * way a decimal to double conversion of the text does
+ */
+double Scale( const uint64_t mantissa, const int exponent )
+{
+    const double value = static_cast< double >( mantissa );
+    if ( exponent >= 0 )
     {
-        throw TleException( "Satellite numbers do not match" );
+        return value * kPowersOfTen[exponent];
     }
-
-    norad_number_ = sat_number_1;
-
-    if ( name_.empty() )
+    else
     {
-        name_ = line_one_.substr( TLE1_COL_NORADNUM, TLE1_LEN_NORADNUM );
+        return value / kPowersOfTen[-exponent];
     }
-
-    int_designator_ = line_one_.substr( TLE1_COL_INTLDESC_A,
-                                        TLE1_LEN_INTLDESC_A + TLE1_LEN_INTLDESC_B + TLE1_LEN_INTLDESC_C );
-
-    unsigned int year = 0;
-    double day = 0.0;
-
-    ExtractInteger( line_one_.substr( TLE1_COL_EPOCH_A,
-                    TLE1_LEN_EPOCH_A ), year );
-    ExtractDouble( line_one_.substr( TLE1_COL_EPOCH_B,
-                   TLE1_LEN_EPOCH_B ), 4, day );
-    ExtractDouble( line_one_.substr( TLE1_COL_MEANMOTIONDT2,
-                   TLE1_LEN_MEANMOTIONDT2 ), 2, mean_motion_dt2_ );
-    ExtractExponential( line_one_.substr( TLE1_COL_MEANMOTIONDDT6,
-                        TLE1_LEN_MEANMOTIONDDT6 ), mean_motion_ddt6_ );
-    ExtractExponential( line_one_.substr( TLE1_COL_BSTAR,
-                        TLE1_LEN_BSTAR ), bstar_ );
-
-    /*
-     * line 2
-     */
-    ExtractDouble( line_two_.substr( TLE2_COL_INCLINATION,
-                   TLE2_LEN_INCLINATION ), 4, inclination_ );
-    ExtractDouble( line_two_.substr( TLE2_COL_RAASCENDNODE,
-                   TLE2_LEN_RAASCENDNODE ), 4, right_ascending_node_ );
-    ExtractDouble( line_two_.substr( TLE2_COL_ECCENTRICITY,
-                   TLE2_LEN_ECCENTRICITY ), -1, eccentricity_ );
-    ExtractDouble( line_two_.substr( TLE2_COL_ARGPERIGEE,
-                   TLE2_LEN_ARGPERIGEE ), 4, argument_perigee_ );
-    ExtractDouble( line_two_.substr( TLE2_COL_MEANANOMALY,
-                   TLE2_LEN_MEANANOMALY ), 4, mean_anomaly_ );
-    ExtractDouble( line_two_.substr( TLE2_COL_MEANMOTION,
-                   TLE2_LEN_MEANMOTION ), 3, mean_motion_ );
-    ExtractInteger( line_two_.substr( TLE2_COL_REVATEPOCH,
-                    TLE2_LEN_REVATEPOCH ), orbit_number_ );
-
-    if ( year < 57 )
-        year += 2000;
-    else
-        year += 1900;
-
-    epoch_ = DateTime( year, day );
 }
 
 /**
- * Check
- * @param str The string to check
- * @returns Whether true of the string has a valid length
- */
-bool Tle::IsValidLineLength( const std::string& str )
-{
-    return str.length() == LineLength() ? true : false;
-}
-
-/**
- * Convert a string containing an integer
- * @param[in] str The string to convert
+ * Convert a field containing an integer
+ * @param[in] str The start of the field
+ * @param[in] length The length of the field
  * @param[out] val The result
- * @exception TleException on conversion error
+ * @returns the reason the field is invalid, or nullptr
  */
-void Tle::ExtractInteger( const std::string& str, unsigned int& val )
+const char* DecodeInteger( const char* str, const unsigned int length, unsigned int& val )
 {
     bool found_digit = false;
     unsigned int temp = 0;
 
-    for ( std::string::const_iterator i = str.begin(); i != str.end(); ++i )
+    for ( unsigned int i = 0; i < length; ++i )
     {
-        if ( isdigit( *i ) )
+        if ( IsDigit( str[i] ) )
         {
             found_digit = true;
-            temp = ( temp * 10 ) + static_cast< unsigned int >( *i - '0' );
+            temp = ( temp * 10 ) + static_cast< unsigned int >( str[i] - '0' );
         }
         else if ( found_digit )
         {
-            throw TleException( "Unexpected non digit" );
+            return "Unexpected non digit";
         }
-        else if ( *i != ' ' )
+        else if ( str[i] != ' ' )
         {
-            throw TleException( "Invalid character" );
+            return "Invalid character";
         }
     }
 
-    if ( !found_digit )
-    {
-        val = 0;
-    }
-    else
-    {
-        val = temp;
-    }
+    val = temp;
+    return nullptr;
 }
 
 /**
- * Convert a string containing an double
- * @param[in] str The string to convert
+ * Convert a field containing a double
+ * @param[in] str The start of the field
+ * @param[in] length The length of the field
  * @param[in] point_pos The position of the decimal point. (-1 if none)
  * @param[out] val The result
- * @exception TleException on conversion error
+ * @returns the reason the field is invalid, or nullptr
  */
-void Tle::ExtractDouble( const std::string& str, int point_pos, double& val )
+const char* DecodeDouble( const char* str, const unsigned int length, const int point_pos, double& val )
 {
-    std::string temp;
+    bool negative = false;
     bool found_digit = false;
+    uint64_t mantissa = 0;
+    int decimals = 0;
 
-    for ( std::string::const_iterator i = str.begin(); i != str.end(); ++i )
+    for ( int i = 0; i < static_cast< int >( length ); ++i )
     {
+        const char c = str[i];
+
         /*
          * integer part
          */
-        if ( point_pos >= 0 && i < str.begin() + point_pos - 1 )
+        if ( point_pos >= 0 && i < point_pos - 1 )
         {
-            bool done = false;
-
-            if ( i == str.begin() )
+            if ( i == 0 && ( c == '-' || c == '+' ) )
             {
-                if ( *i == '-' || *i == '+' )
-                {
-                    /*
-                     * first character could be signed
-                     */
-                    temp += *i;
-                    done = true;
-                }
+                /*
+                 * first character could be signed
+                 */
+                negative = c == '-';
             }
-
-            if ( !done )
+            else if ( IsDigit( c ) )
+            {
+                found_digit = true;
+                mantissa = mantissa * 10 + static_cast< uint64_t >( c - '0' );
+            }
+            else if ( found_digit )
             {
-                if ( isdigit( *i ) )
-                {
-                    found_digit = true;
-                    temp += *i;
-                }
-                else if ( found_digit )
-                {
-                    throw TleException( "Unexpected non digit" );
-                }
-                else if ( *i != ' ' )
-                {
-                    throw TleException( "Invalid character" );
-                }
+                return "Unexpected non digit";
+            }
+            else if ( c != ' ' )
+            {
+                return "Invalid character";
             }
         }
         /*
          * decimal point
          */
-        else if ( point_pos >= 0 && i == str.begin() + point_pos - 1 )
+        else if ( point_pos >= 0 && i == point_pos - 1 )
         {
-            if ( temp.length() == 0 )
+            if ( c != '.' )
             {
-                /*
-                 * integer part is blank, so add a '0'
-                 */
-                temp += '0';
-            }
-
-            if ( *i == '.' )
-            {
-                /*
-                 * decimal point found
-                 */
-                temp += *i;
-            }
-            else
-            {
-                throw TleException( "Failed to find decimal point" );
+                return "Failed to find decimal point";
             }
         }
         /*
-         * fraction part
+         * fraction part, without a decimal point the whole field
          */
         else
         {
-            if ( i == str.begin() && point_pos == -1 )
-            {
-                /*
-                 * no decimal point expected, add 0. beginning
-                 */
-                temp += '0';
-                temp += '.';
-            }
-
-            /*
-             * should be a digit
-             */
-            if ( isdigit( *i ) )
-            {
-                temp += *i;
-            }
-            else
+            if ( !IsDigit( c ) )
             {
-                throw TleException( "Invalid digit" );
+                return "Invalid digit";
             }
+            mantissa = mantissa * 10 + static_cast< uint64_t >( c - '0' );
+            decimals++;
         }
     }
 
-    if ( !Util::FromString<double>( temp, val ) )
-    {
-        throw TleException( "Failed to convert value to double" );
-    }
+    const double value = Scale( mantissa, -decimals );
+    val = negative ? -value : value;
+    return nullptr;
 }
 
 /**
- * Convert a string containing an exponential
- * @param[in] str The string to convert
+ * Convert a field containing an exponential, such as -11606-4
+ * @param[in] str The start of the field
+ * @param[in] length The length of the field
  * @param[out] val The result
- * @exception TleException on conversion error
+ * @returns the reason the field is invalid, or nullptr
  */
-void Tle::ExtractExponential( const std::string& str, double& val )
+const char* DecodeExponential( const char* str, const unsigned int length, double& val )
 {
-    std::string temp;
+    bool negative = false;
+    bool negative_exponent = false;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
 
-    for ( std::string::const_iterator i = str.begin(); i != str.end(); ++i )
+    for ( unsigned int i = 0; i < length; ++i )
     {
-        if ( i == str.begin() )
+        const char c = str[i];
+
+        if ( i == 0 )
         {
-            if ( *i == '-' || *i == '+' || *i == ' ' )
+            if ( c == '-' || c == '+' || c == ' ' )
             {
-                if ( *i == '-' )
-                {
-                    temp += *i;
-                }
-                temp += '0';
-                temp += '.';
+                negative = c == '-';
             }
             else
             {
-                throw TleException( "Invalid sign" );
+                return "Invalid sign";
             }
         }
-        else if ( i == str.end() - 2 )
+        else if ( i == length - 2 )
         {
-            if ( *i == '-' || *i == '+' )
+            if ( c == '-' || c == '+' )
             {
-                temp += 'e';
-                temp += *i;
+                negative_exponent = c == '-';
             }
             else
             {
-                throw TleException( "Invalid exponential sign" );
+                return "Invalid exponential sign";
             }
         }
+        else if ( !IsDigit( c ) )
+        {
+            return "Invalid digit";
+        }
+        else if ( i == length - 1 )
+        {
+            exponent = c - '0';
+        }
         else
         {
-            if ( isdigit( *i ) )
-            {
-                temp += *i;
-            }
-            else
-            {
-                throw TleException( "Invalid digit" );
-            }
+            mantissa = mantissa * 10 + static_cast< uint64_t >( c - '0' );
+            digits++;
         }
     }
 
-    if ( !Util::FromString<double>( temp, val ) )
+    /*
+     * the digits follow an implied decimal point
+     */
+    const double value = Scale( mantissa,
+            ( negative_exponent ? -exponent : exponent ) - digits );
+    val = negative ? -value : value;
+    return nullptr;
+}
+}
+
+/**
+ * Initialise the tle object.
+ * @exception TleException
+ */
+void Tle::Initialize()
+{
+    TleRecord record;
+    const char* field;
+    const char* reason = Parse( line_one_.data(), line_one_.length(),
+                                line_two_.data(), line_two_.length(),
+                                record, field );
+
+    if ( reason )
+    {
+        throw TleException( reason );
+    }
+
+    norad_number_ = record.norad_number;
+
+    if ( name_.empty() )
+    {
+        name_ = record.name;
+    }
+
+    int_designator_ = record.int_designator;
+    epoch_ = record.epoch;
+    mean_motion_dt2_ = record.mean_motion_dt2;
+    mean_motion_ddt6_ = record.mean_motion_ddt6;
+    bstar_ = record.bstar;
+    inclination_ = record.inclination;
+    right_ascending_node_ = record.right_ascending_node;
+    eccentricity_ = record.eccentricity;
+    argument_perigee_ = record.argument_perigee;
+    mean_anomaly_ = record.mean_anomaly;
+    mean_motion_ = record.mean_motion;
+    orbit_number_ = record.orbit_number;
+}
+
+const char* Tle::Parse( const char* line_one,
+                        const size_t line_one_length,
+                        const char* line_two,
+                        const size_t line_two_length,
+                        TleRecord& record,
+                        const char*& field )
+{
+    const char* reason = nullptr;
+
+    field = "line one";
+    if ( line_one_length != LineLength() )
+    {
+        return "Invalid length for line one";
+    }
+
+    field = "line two";
+    if ( line_two_length != LineLength() )
+    {
+        return "Invalid length for line two";
+    }
+
+    field = "line one";
+    if ( line_one[ 0 ] != '1' )
+    {
+        return "Invalid line beginning for line one";
+    }
+
+    field = "line two";
+    if ( line_two[ 0 ] != '2' )
     {
-        throw TleException( "Failed to convert value to double" );
+        return "Invalid line beginning for line two";
     }
+
+    unsigned int sat_number_2;
+
+    field = "norad number";
+    if ( ( reason = DecodeInteger( line_one + TLE1_COL_NORADNUM,
+                    TLE1_LEN_NORADNUM, record.norad_number ) ) ||
+         ( reason = DecodeInteger( line_two + TLE2_COL_NORADNUM,
+                    TLE2_LEN_NORADNUM, sat_number_2 ) ) )
+    {
+        return reason;
+    }
+
+    if ( record.norad_number != sat_number_2 )
+    {
+        return "Satellite numbers do not match";
+    }
+
+    std::memcpy( record.name, line_one + TLE1_COL_NORADNUM, TLE1_LEN_NORADNUM );
+    record.name[ TLE1_LEN_NORADNUM ] = '\0';
+
+    const unsigned int designator_length =
+        TLE1_LEN_INTLDESC_A + TLE1_LEN_INTLDESC_B + TLE1_LEN_INTLDESC_C;
+    std::memcpy( record.int_designator, line_one + TLE1_COL_INTLDESC_A, designator_length );
+    record.int_designator[ designator_length ] = '\0';
+
+    unsigned int year = 0;
+    double day = 0.0;
+
+    field = "epoch";
+    if ( ( reason = DecodeInteger( line_one + TLE1_COL_EPOCH_A,
+                    TLE1_LEN_EPOCH_A, year ) ) ||
+         ( reason = DecodeDouble( line_one + TLE1_COL_EPOCH_B,
+                    TLE1_LEN_EPOCH_B, 4, day ) ) )
+    {
+        return reason;
+    }
+
+    field = "mean motion dt2";
+    if ( ( reason = DecodeDouble( line_one + TLE1_COL_MEANMOTIONDT2,
+                    TLE1_LEN_MEANMOTIONDT2, 2, record.mean_motion_dt2 ) ) )
+    {
+        return reason;
+    }
+
+    field = "mean motion ddt6";
+    if ( ( reason = DecodeExponential( line_one + TLE1_COL_MEANMOTIONDDT6,
+                    TLE1_LEN_MEANMOTIONDDT6, record.mean_motion_ddt6 ) ) )
+    {
+        return reason;
+    }
+
+    field = "bstar";
+    if ( ( reason = DecodeExponential( line_one + TLE1_COL_BSTAR,
+                    TLE1_LEN_BSTAR, record.bstar ) ) )
+    {
+        return reason;
+    }
+
+    /*
+     * line 2
+     */
+    field = "inclination";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_INCLINATION,
+                    TLE2_LEN_INCLINATION, 4, record.inclination ) ) )
+    {
+        return reason;
+    }
+
+    field = "right ascending node";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_RAASCENDNODE,
+                    TLE2_LEN_RAASCENDNODE, 4, record.right_ascending_node ) ) )
+    {
+        return reason;
+    }
+
+    field = "eccentricity";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_ECCENTRICITY,
+                    TLE2_LEN_ECCENTRICITY, -1, record.eccentricity ) ) )
+    {
+        return reason;
+    }
+
+    field = "argument perigee";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_ARGPERIGEE,
+                    TLE2_LEN_ARGPERIGEE, 4, record.argument_perigee ) ) )
+    {
+        return reason;
+    }
+
+    field = "mean anomaly";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_MEANANOMALY,
+                    TLE2_LEN_MEANANOMALY, 4, record.mean_anomaly ) ) )
+    {
+        return reason;
+    }
+
+    field = "mean motion";
+    if ( ( reason = DecodeDouble( line_two + TLE2_COL_MEANMOTION,
+                    TLE2_LEN_MEANMOTION, 3, record.mean_motion ) ) )
+    {
+        return reason;
+    }
+
+    field = "orbit number";
+    if ( ( reason = DecodeInteger( line_two + TLE2_COL_REVATEPOCH,
+                    TLE2_LEN_REVATEPOCH, record.orbit_number ) ) )
+    {
+        return reason;
+    }
+
+    if ( year < 57 )
+        year += 2000;
+    else
+        year += 1900;
+
+    record.epoch = DateTime( year, day );
+
+    field = nullptr;
+    return nullptr;
 }
 
 } //namespace SGP4
\ No newline at end of file
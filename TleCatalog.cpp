@@ -0,0 +1,178 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/TleCatalog.h>
+#include <SGP4/MappedFile.h>
+#include <SGP4/TleCatalogReader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace SGP4 {
+
+namespace {
+/*
+ * enough records per chunk to cover the cost of starting a reader, with
+ * several chunks per thread to even out the load
+ */
+static const size_t kMinChunkSize = 256 * 1024;
+static const unsigned int kChunksPerThread = 4;
+
+struct Chunk
+{
+    size_t begin;
+    size_t end;
+    size_t lines;
+    std::vector< TleRecord > records;
+    std::vector< TleCatalogError > errors;
+};
+
+void LoadChunk( const char* data, Chunk& chunk )
+{
+    const size_t size = chunk.end - chunk.begin;
+    chunk.lines = static_cast< size_t >(
+            std::count( data + chunk.begin, data + chunk.end, '\n' ) );
+
+    /*
+     * a record with its line endings is at least 140 bytes
+     */
+    chunk.records.reserve( size / 140 + 1 );
+
+    TleCatalogReader reader( data + chunk.begin, size );
+    TleRecord record;
+    TleCatalogError error;
+
+    while ( reader.Next( record, error.field, error.reason ) )
+    {
+        if ( error.reason )
+        {
+            error.line = reader.LineNumber();
+            chunk.errors.push_back( error );
+        }
+        else
+        {
+            chunk.records.push_back( record );
+        }
+    }
+}
+}
+
+TleCatalog::TleCatalog( const std::string& filename, const unsigned int threads )
+{
+    const MappedFile file( filename );
+    Load( file.Data(), file.Size(), threads );
+}
+
+void TleCatalog::Load( const char* data, const size_t size, unsigned int threads )
+{
+    if ( threads == 0 )
+    {
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+
+    size_t chunk_count = std::min< size_t >( threads * kChunksPerThread,
+                                             size / kMinChunkSize + 1 );
+    threads = static_cast< unsigned int >(
+            std::min< size_t >( threads, chunk_count ) );
+
+    /*
+     * how the lines group into records depends on every line before them,
+     * so the chunk boundaries come from framing the whole catalog in order
+     * as a serial read would. framing only looks at the line lengths and
+     * first columns, so this thread frames the chunks while the pool
+     * decodes those already framed
+     */
+    std::vector< Chunk > chunks( chunk_count );
+    std::atomic< size_t > framed( 0 );
+    std::atomic< size_t > next_chunk( 0 );
+    auto worker = [ & ]()
+    {
+        for ( size_t i = next_chunk++; i < chunk_count; i = next_chunk++ )
+        {
+            while ( framed.load( std::memory_order_acquire ) <= i )
+            {
+                std::this_thread::yield();
+            }
+            LoadChunk( data, chunks[i] );
+        }
+    };
+
+    std::vector< std::thread > pool;
+    for ( unsigned int t = 1; t < threads; t++ )
+    {
+        pool.push_back( std::thread( worker ) );
+    }
+
+    TleCatalogReader framer( data, size );
+    size_t begin = 0;
+    for ( size_t i = 0; i < chunk_count; i++ )
+    {
+        chunks[i].begin = begin;
+        if ( i + 1 < chunk_count )
+        {
+            const size_t target = size / chunk_count * ( i + 1 );
+            while ( framer.Position() < target && framer.Skip() )
+            {
+            }
+            begin = framer.Position();
+        }
+        else
+        {
+            begin = size;
+        }
+        chunks[i].end = begin;
+        framed.store( i + 1, std::memory_order_release );
+    }
+
+    worker();
+    for ( size_t t = 0; t < pool.size(); t++ )
+    {
+        pool[t].join();
+    }
+
+    /*
+     * join the chunks in file order, offsetting the line numbers of
+     * each chunk by the lines before it
+     */
+    size_t record_count = 0;
+    size_t error_count = 0;
+    for ( size_t i = 0; i < chunk_count; i++ )
+    {
+        record_count += chunks[i].records.size();
+        error_count += chunks[i].errors.size();
+    }
+
+    m_records.reserve( record_count );
+    m_errors.reserve( error_count );
+
+    size_t lines = 0;
+    for ( size_t i = 0; i < chunk_count; i++ )
+    {
+        m_records.insert( m_records.end(),
+                          chunks[i].records.begin(), chunks[i].records.end() );
+        for ( size_t e = 0; e < chunks[i].errors.size(); e++ )
+        {
+            TleCatalogError error = chunks[i].errors[e];
+            error.line += lines;
+            m_errors.push_back( error );
+        }
+        lines += chunks[i].lines;
+    }
+}
+
+} //namespace SGP4
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/TleCatalogReader.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace SGP4 {
+
+TleCatalogReader::TleCatalogReader( const std::string& filename )
+    : m_file( filename, true )
+    , m_data( m_file.Data() )
+    , m_size( m_file.Size() )
+    , m_pos( 0 )
+    , m_line( 0 )
+    , m_record_line( 0 )
+{
+}
+
+TleCatalogReader::TleCatalogReader( const char* data, const size_t size )
+    : m_data( data )
+    , m_size( size )
+    , m_pos( 0 )
+    , m_line( 0 )
+    , m_record_line( 0 )
+{
+}
+
+/**
+ * Find the next non blank line
+ * @param[out] line the start of the line
+ * @param[out] length the length of the line, without the line ending
+ * @returns false at the end of the catalog
+ */
+bool TleCatalogReader::NextLine( const char*& line, size_t& length )
+{
+    while ( m_pos < m_size )
+    {
+        const char* start = m_data + m_pos;
+        const char* end = static_cast< const char* >(
+                std::memchr( start, '\n', m_size - m_pos ) );
+        const size_t line_length = end ? static_cast< size_t >( end - start ) : m_size - m_pos;
+
+        m_pos += line_length + ( end ? 1 : 0 );
+        m_line++;
+
+        length = line_length;
+        if ( length > 0 && start[ length - 1 ] == '\r' )
+        {
+            length--;
+        }
+
+        if ( length > 0 )
+        {
+            line = start;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TleCatalogReader::Next( TleRecord& record )
+{
+    const char* field;
+    const char* reason;
+    if ( !Next( record, field, reason ) )
+    {
+        return false;
+    }
+
+    if ( reason )
+    {
+        throw TleException( reason );
+    }
+
+    return true;
+}
+
+/**
+ * Group the next lines into a record, without decoding them
+ * @param[out] frame the lines of the record
+ * @param[out] field the missing line when the catalog ends early
+ * @param[out] reason the reason the record is incomplete, or nullptr
+ * @returns false at the end of the catalog
+ */
+bool TleCatalogReader::NextFrame( Frame& frame, const char*& field, const char*& reason )
+{
+    const char* first;
+    size_t first_length;
+    if ( !NextLine( first, first_length ) )
+    {
+        return false;
+    }
+    m_record_line = m_line;
+
+    frame.name = nullptr;
+    frame.name_length = 0;
+    frame.line_one = first;
+    frame.line_one_length = first_length;
+    frame.line_two = nullptr;
+    frame.line_two_length = 0;
+    reason = nullptr;
+
+    /*
+     * a line that is not line one of a tle names the satellite
+     */
+    if ( first_length != Tle::LineLength() || first[ 0 ] != '1' )
+    {
+        if ( !NextLine( frame.line_one, frame.line_one_length ) )
+        {
+            field = "line one";
+            reason = "Unexpected end of catalog";
+            return true;
+        }
+
+        if ( frame.line_one_length == Tle::LineLength() && frame.line_one[ 0 ] == '2' )
+        {
+            /*
+             * a damaged line one rather than a name, keep it as line one
+             * so the next record is not consumed as this line two
+             */
+            frame.line_two = frame.line_one;
+            frame.line_two_length = frame.line_one_length;
+            frame.line_one = first;
+            frame.line_one_length = first_length;
+        }
+        else
+        {
+            frame.name = first;
+            frame.name_length = first_length;
+        }
+    }
+
+    if ( !frame.line_two && !NextLine( frame.line_two, frame.line_two_length ) )
+    {
+        field = "line two";
+        reason = "Unexpected end of catalog";
+    }
+
+    return true;
+}
+
+bool TleCatalogReader::Next( TleRecord& record, const char*& field, const char*& reason )
+{
+    Frame frame;
+    if ( !NextFrame( frame, field, reason ) )
+    {
+        return false;
+    }
+
+    if ( reason )
+    {
+        return true;
+    }
+
+    reason = Tle::Parse( frame.line_one, frame.line_one_length,
+                         frame.line_two, frame.line_two_length,
+                         record, field );
+    if ( reason )
+    {
+        return true;
+    }
+
+    if ( frame.name )
+    {
+        size_t name_length = frame.name_length;
+        while ( name_length > 0 && frame.name[ name_length - 1 ] == ' ' )
+        {
+            name_length--;
+        }
+        name_length = std::min( name_length, sizeof( record.name ) - 1 );
+        std::memcpy( record.name, frame.name, name_length );
+        record.name[ name_length ] = '\0';
+    }
+
+    return true;
+}
+
+bool TleCatalogReader::Skip()
+{
+    Frame frame;
+    const char* field;
+    const char* reason;
+    return NextFrame( frame, field, reason );
+}
+
+} //namespace SGP4
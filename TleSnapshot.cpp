@@ -0,0 +1,297 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/TleSnapshot.h>
+#include <SGP4/OrbitalElements.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+namespace SGP4 {
+
+namespace {
+static const char kMagic[8] = { 'S', 'G', 'P', '4', 'S', 'N', 'A', 'P' };
+static const uint32_t kVersion = 2;
+static const uint32_t kByteOrder = 0x01020304;
+static const uint32_t kHasConstants = 1;
+
+/*
+ * arrays start on a multiple of this from the start of the file
+ */
+static const uint64_t kAlignment = 64;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint32_t record_size;
+    uint32_t state_size;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t records_offset;
+    uint64_t states_offset;
+};
+
+uint64_t Align( const uint64_t offset )
+{
+    return ( offset + kAlignment - 1 ) / kAlignment * kAlignment;
+}
+
+void WritePadding( std::ofstream& file, const uint64_t from, const uint64_t to )
+{
+    static const char zeros[kAlignment] = {};
+    file.write( zeros, static_cast< std::streamsize >( to - from ) );
+}
+
+/*
+ * whether an array of count elements at offset lies after the header and
+ * inside the file, aligned for its element type, without the arithmetic
+ * overflowing
+ */
+bool FitsInFile( const uint64_t file_size,
+                 const uint64_t offset,
+                 const uint64_t count,
+                 const uint64_t size,
+                 const uint64_t alignment )
+{
+    return offset >= sizeof( Header )
+        && offset % alignment == 0
+        && offset <= file_size
+        && count <= ( file_size - offset ) / size;
+}
+
+/*
+ * whether the byte at offset in object is a bool value, 0 or 1
+ */
+bool IsBool( const void* object, const size_t offset )
+{
+    unsigned char byte;
+    std::memcpy( &byte, static_cast< const char* >( object ) + offset, 1 );
+    return byte <= 1;
+}
+}
+
+/*
+ * the stored constants of a record, valid is zero when SGP4 rejected the
+ * elements
+ */
+struct TleSnapshot::State
+{
+    SGP4::InitialisedState state;
+    uint8_t valid;
+
+    /*
+     * whether valid and the flags in state hold a bool value, anything else
+     * is a corrupt file and must not be read as bool
+     */
+    bool HasBoolFlags() const
+    {
+        const size_t deepspace = offsetof( State, state )
+            + offsetof( SGP4::InitialisedState, deepspace_consts );
+        return IsBool( this, offsetof( State, valid ) )
+            && IsBool( this, offsetof( State, state )
+                    + offsetof( SGP4::InitialisedState, use_simple_model ) )
+            && IsBool( this, offsetof( State, state )
+                    + offsetof( SGP4::InitialisedState, use_deep_space ) )
+            && IsBool( this, deepspace
+                    + offsetof( SGP4::DeepSpaceConstants, resonance_flag ) )
+            && IsBool( this, deepspace
+                    + offsetof( SGP4::DeepSpaceConstants, synchronous_flag ) );
+    }
+};
+
+void TleSnapshot::Write( const std::string& filename,
+                         const std::vector< TleRecord >& records,
+                         const bool with_constants )
+{
+    std::ofstream file( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !file )
+    {
+        throw TleException( "Failed to open file" );
+    }
+
+    Header header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, kMagic, sizeof( kMagic ) );
+    header.version = kVersion;
+    header.byte_order = kByteOrder;
+    header.flags = with_constants ? kHasConstants : 0;
+    header.record_size = sizeof( TleRecord );
+    header.state_size = sizeof( State );
+    header.count = records.size();
+    header.records_offset = Align( sizeof( Header ) );
+    const uint64_t records_end = header.records_offset + records.size() * sizeof( TleRecord );
+    header.states_offset = with_constants ? Align( records_end ) : 0;
+
+    file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    WritePadding( file, sizeof( header ), header.records_offset );
+
+    /*
+     * copy field by field into zeroed records, so padding and the bytes
+     * after the strings are written as zeros
+     */
+    for ( size_t i = 0; i < records.size(); i++ )
+    {
+        TleRecord record;
+        std::memset( static_cast< void* >( &record ), 0, sizeof( record ) );
+        std::memcpy( record.name, records[i].name,
+                     std::strlen( records[i].name ) );
+        std::memcpy( record.int_designator, records[i].int_designator,
+                     std::strlen( records[i].int_designator ) );
+        record.norad_number = records[i].norad_number;
+        record.orbit_number = records[i].orbit_number;
+        record.epoch = records[i].epoch;
+        record.mean_motion_dt2 = records[i].mean_motion_dt2;
+        record.mean_motion_ddt6 = records[i].mean_motion_ddt6;
+        record.bstar = records[i].bstar;
+        record.inclination = records[i].inclination;
+        record.right_ascending_node = records[i].right_ascending_node;
+        record.eccentricity = records[i].eccentricity;
+        record.argument_perigee = records[i].argument_perigee;
+        record.mean_anomaly = records[i].mean_anomaly;
+        record.mean_motion = records[i].mean_motion;
+        file.write( reinterpret_cast< const char* >( &record ), sizeof( record ) );
+    }
+
+    if ( with_constants )
+    {
+        WritePadding( file, records_end, header.states_offset );
+
+        for ( size_t i = 0; i < records.size(); i++ )
+        {
+            State state;
+            std::memset( &state, 0, sizeof( state ) );
+            try
+            {
+                const SGP4 sgp4( OrbitalElements( records[i] ) );
+                sgp4.SaveState( state.state );
+                state.valid = 1;
+            }
+            catch ( SatelliteException& )
+            {
+                state.valid = 0;
+            }
+            file.write( reinterpret_cast< const char* >( &state ), sizeof( state ) );
+        }
+    }
+
+    if ( !file )
+    {
+        throw TleException( "Failed to write file" );
+    }
+}
+
+TleSnapshot::TleSnapshot( const std::string& filename )
+    : m_file( filename )
+    , m_count( 0 )
+    , m_records( nullptr )
+    , m_states( nullptr )
+{
+    if ( m_file.Size() < sizeof( Header ) )
+    {
+        throw TleException( "Invalid snapshot" );
+    }
+
+    Header header;
+    std::memcpy( &header, m_file.Data(), sizeof( header ) );
+
+    if ( std::memcmp( header.magic, kMagic, sizeof( kMagic ) ) != 0 )
+    {
+        throw TleException( "Invalid snapshot" );
+    }
+
+    if ( header.version != kVersion
+            || header.byte_order != kByteOrder
+            || header.record_size != sizeof( TleRecord )
+            || header.state_size != sizeof( State ) )
+    {
+        throw TleException( "Unsupported snapshot version" );
+    }
+
+    const bool has_constants = ( header.flags & kHasConstants ) != 0;
+    if ( !FitsInFile( m_file.Size(), header.records_offset, header.count,
+                      sizeof( TleRecord ), alignof( TleRecord ) )
+            || ( has_constants
+                && !FitsInFile( m_file.Size(), header.states_offset, header.count,
+                                sizeof( State ), alignof( State ) ) ) )
+    {
+        throw TleException( "Truncated snapshot" );
+    }
+
+    /*
+     * both ends are within the file now, so they cannot overflow
+     */
+    const uint64_t records_end = header.records_offset + header.count * sizeof( TleRecord );
+    const uint64_t states_end = header.states_offset + header.count * sizeof( State );
+    if ( has_constants
+            && header.records_offset < states_end
+            && header.states_offset < records_end )
+    {
+        throw TleException( "Invalid snapshot" );
+    }
+
+    m_count = static_cast< size_t >( header.count );
+    m_records = reinterpret_cast< const TleRecord* >(
+            m_file.Data() + header.records_offset );
+
+    /*
+     * the names are read as C strings, so each must end within its field
+     */
+    for ( size_t i = 0; i < m_count; i++ )
+    {
+        const TleRecord& record = m_records[i];
+        if ( !std::memchr( record.name, '\0', sizeof( record.name ) )
+                || !std::memchr( record.int_designator, '\0',
+                                 sizeof( record.int_designator ) ) )
+        {
+            throw TleException( "Invalid snapshot" );
+        }
+    }
+
+    if ( has_constants )
+    {
+        m_states = reinterpret_cast< const State* >(
+                m_file.Data() + header.states_offset );
+        for ( size_t i = 0; i < m_count; i++ )
+        {
+            if ( !m_states[i].HasBoolFlags() )
+            {
+                throw TleException( "Invalid snapshot" );
+            }
+        }
+    }
+}
+
+SGP4 TleSnapshot::Propagator( const size_t i ) const
+{
+    const OrbitalElements elements( m_records[i] );
+
+    if ( m_states && m_states[i].valid )
+    {
+        return SGP4( elements, m_states[i].state );
+    }
+
+    /*
+     * rejected elements throw the same exception as before
+     */
+    return SGP4( elements );
+}
+
+} //namespace SGP4
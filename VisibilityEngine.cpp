@@ -0,0 +1,271 @@
+/*
+ * Copyright 2013 Daniel Warner <contact@danrw.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <SGP4/VisibilityEngine.h>
+#include <SGP4/Eci.h>
+#include <SGP4/Globals.h>
+#include <SGP4/Util.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SGP4 {
+
+namespace {
+static const int kCellRows = 36;
+static const int kCellColumns = 72;
+static const double kCellSize = kPI / kCellRows;
+/*
+ * allowance for the spherical footprint against geodetic elevation
+ */
+static const double kFootprintMargin = Util::DegreesToRadians( 1.0 );
+
+int Row( const double latitude )
+{
+    const int row = static_cast< int >( floor( ( latitude + kPI / 2.0 ) / kCellSize ) );
+    return std::min( std::max( row, 0 ), kCellRows - 1 );
+}
+
+int Column( const double longitude )
+{
+    const int column = static_cast< int >( floor( Util::WrapTwoPI( longitude ) / kCellSize ) );
+    return std::min( std::max( column, 0 ), kCellColumns - 1 );
+}
+}
+
+VisibilityEngine::VisibilityEngine( const std::vector< OrbitalElements >& satellites,
+                                    const std::vector< CoordGeodetic >& stations,
+                                    const double min_elevation )
+    : m_batch( satellites )
+    , m_min_elevation( Util::DegreesToRadians( min_elevation ) )
+    , m_sin_min_elevation( sin( Util::DegreesToRadians( min_elevation ) ) )
+    , m_cos_min_elevation( cos( Util::DegreesToRadians( min_elevation ) ) )
+    , m_min_radius( kXKMPER )
+    , m_positions( satellites.size() )
+    , m_velocities( satellites.size() )
+    , m_statuses( satellites.size() )
+{
+    /*
+     * earth fixed positions, taking into account earth flattening
+     */
+    std::vector< Vector > positions( stations.size() );
+    std::vector< int > cells( stations.size() );
+    for ( size_t i = 0; i < stations.size(); i++ )
+    {
+        const CoordGeodetic& geo = stations[i];
+        double achcp;
+        double z;
+        Eci::EarthFixedDistances( geo, achcp, z );
+
+        positions[i] = Vector( achcp * cos( geo.longitude ),
+                               achcp * sin( geo.longitude ),
+                               z );
+        m_min_radius = std::min( m_min_radius, positions[i].Magnitude() );
+
+        const double geocentric_latitude = atan2( positions[i].z,
+                sqrt( positions[i].x * positions[i].x + positions[i].y * positions[i].y ) );
+        cells[i] = Row( geocentric_latitude ) * kCellColumns + Column( geo.longitude );
+    }
+
+    /*
+     * counting sort of the stations by cell
+     */
+    m_cell_start.assign( kCellRows * kCellColumns + 1, 0 );
+    for ( size_t i = 0; i < stations.size(); i++ )
+    {
+        m_cell_start[cells[i] + 1]++;
+    }
+    for ( size_t c = 0; c < kCellRows * kCellColumns; c++ )
+    {
+        m_cell_start[c + 1] += m_cell_start[c];
+    }
+
+    m_station_index.resize( stations.size() );
+    std::vector< size_t > fill( m_cell_start.begin(), m_cell_start.end() - 1 );
+    for ( size_t i = 0; i < stations.size(); i++ )
+    {
+        m_station_index[fill[cells[i]]++] = i;
+    }
+
+    m_x.resize( stations.size() );
+    m_y.resize( stations.size() );
+    m_z.resize( stations.size() );
+    m_sin_lat.resize( stations.size() );
+    m_cos_lat.resize( stations.size() );
+    m_sin_lon.resize( stations.size() );
+    m_cos_lon.resize( stations.size() );
+    for ( size_t k = 0; k < stations.size(); k++ )
+    {
+        const size_t i = m_station_index[k];
+        m_x[k] = positions[i].x;
+        m_y[k] = positions[i].y;
+        m_z[k] = positions[i].z;
+        m_sin_lat[k] = sin( stations[i].latitude );
+        m_cos_lat[k] = cos( stations[i].latitude );
+        m_sin_lon[k] = sin( stations[i].longitude );
+        m_cos_lon[k] = cos( stations[i].longitude );
+    }
+}
+
+void VisibilityEngine::FindVisible( const DateTime& dt, std::vector< Visibility >& visible )
+{
+    visible.clear();
+    m_batch.FindPositions( dt, m_positions.data(), m_velocities.data(), m_statuses.data() );
+
+    /*
+     * one rotation into the earth fixed frame for every satellite
+     */
+    const EarthOrientation orientation( dt );
+
+    for ( size_t sat = 0; sat < m_positions.size(); sat++ )
+    {
+        if ( m_statuses[sat] != SatelliteBatch::Status::Ok )
+        {
+            continue;
+        }
+
+        const Vector& p = m_positions[sat];
+        const Vector& v = m_velocities[sat];
+        const Vector position = orientation.ToEarthFixed( p );
+        /*
+         * velocity relative to the rotating earth
+         */
+        const Vector velocity = orientation.ToEarthFixed( v )
+            + Vector( kEARTH_ROTATION * position.y, -kEARTH_ROTATION * position.x, 0.0 );
+
+        const double r = position.Magnitude();
+        const double cos_footprint = m_min_radius * m_cos_min_elevation / r;
+        if ( cos_footprint >= 1.0 )
+        {
+            continue;
+        }
+
+        /*
+         * angle from the sub satellite point, seen from the centre of the
+         * earth, within which a station can see the satellite
+         */
+        const double footprint = acos( cos_footprint ) - m_min_elevation
+            + kFootprintMargin;
+        const double latitude = asin( position.z / r );
+        const double longitude = atan2( position.y, position.x );
+
+        const int first_row = Row( latitude - footprint );
+        const int last_row = Row( latitude + footprint );
+
+        /*
+         * all longitudes when the footprint covers a pole
+         */
+        const bool all_columns = latitude + footprint >= kPI / 2.0
+            || latitude - footprint <= -kPI / 2.0
+            || footprint >= kPI / 2.0;
+
+        for ( int row = first_row; row <= last_row; row++ )
+        {
+            const size_t row_start = static_cast< size_t >( row * kCellColumns );
+            if ( all_columns )
+            {
+                AddStations( sat, position, velocity, m_cell_start[row_start],
+                             m_cell_start[row_start + kCellColumns], visible );
+                continue;
+            }
+
+            const double half_width = asin( std::min( 1.0, sin( footprint ) / cos( latitude ) ) );
+            const int first_column = static_cast< int >(
+                    floor( ( longitude - half_width ) / kCellSize ) );
+            const int last_column = static_cast< int >(
+                    floor( ( longitude + half_width ) / kCellSize ) );
+
+            if ( last_column - first_column + 1 >= kCellColumns )
+            {
+                AddStations( sat, position, velocity, m_cell_start[row_start],
+                             m_cell_start[row_start + kCellColumns], visible );
+                continue;
+            }
+
+            /*
+             * columns run in two pieces where they wrap past 360 degrees
+             */
+            const int begin = ( first_column + kCellColumns ) % kCellColumns;
+            const int end = ( last_column + kCellColumns ) % kCellColumns;
+            if ( begin <= end )
+            {
+                AddStations( sat, position, velocity, m_cell_start[row_start + begin],
+                             m_cell_start[row_start + end + 1], visible );
+            }
+            else
+            {
+                AddStations( sat, position, velocity, m_cell_start[row_start + begin],
+                             m_cell_start[row_start + kCellColumns], visible );
+                AddStations( sat, position, velocity, m_cell_start[row_start],
+                             m_cell_start[row_start + end + 1], visible );
+            }
+        }
+    }
+}
+
+/*
+ * the exact elevation test for the stations of a run of cells, with the
+ * look angle computed as Observer::GetLookAngle does in the earth fixed
+ * frame
+ */
+void VisibilityEngine::AddStations( const size_t satellite,
+                                    const Vector& position,
+                                    const Vector& velocity,
+                                    const size_t cell_begin,
+                                    const size_t cell_end,
+                                    std::vector< Visibility >& visible ) const
+{
+    for ( size_t k = cell_begin; k < cell_end; k++ )
+    {
+        const double rx = position.x - m_x[k];
+        const double ry = position.y - m_y[k];
+        const double rz = position.z - m_z[k];
+        const double range = sqrt( rx * rx + ry * ry + rz * rz );
+
+        const double top_z = m_cos_lat[k] * m_cos_lon[k] * rx
+            + m_cos_lat[k] * m_sin_lon[k] * ry + m_sin_lat[k] * rz;
+        if ( top_z < m_sin_min_elevation * range )
+        {
+            continue;
+        }
+
+        const double top_s = m_sin_lat[k] * m_cos_lon[k] * rx
+            + m_sin_lat[k] * m_sin_lon[k] * ry - m_cos_lat[k] * rz;
+        const double top_e = -m_sin_lon[k] * rx + m_cos_lon[k] * ry;
+
+        double az = atan( -top_e / top_s );
+        if ( top_s > 0.0 )
+        {
+            az += kPI;
+        }
+        if ( az < 0.0 )
+        {
+            az += 2.0 * kPI;
+        }
+
+        Visibility visibility;
+        visibility.satellite = satellite;
+        visibility.station = m_station_index[k];
+        visibility.look_angle = CoordTopocentric( az,
+                asin( top_z / range ),
+                range,
+                ( rx * velocity.x + ry * velocity.y + rz * velocity.z ) / range );
+        visible.push_back( visibility );
+    }
+}
+
+} //namespace SGP4
@@ -0,0 +1,667 @@
+#include <SGP4/CoordGeodetic.h>
+#include <SGP4/CoordTopocentric.h>
+#include <SGP4/DateTime.h>
+#include <SGP4/Eci.h>
+#include <SGP4/Observer.h>
+#include <SGP4/PassPredictor.h>
+#include <SGP4/SGP4.h>
+#include <SGP4/SatelliteBatch.h>
+#include <SGP4/SolarEphemerisTable.h>
+#include <SGP4/SolarPosition.h>
+#include <SGP4/StationNetwork.h>
+#include <SGP4/Tle.h>
+#include <SGP4/TleCatalog.h>
+#include <SGP4/TleCatalogReader.h>
+#include <SGP4/VisibilityEngine.h>
+#include "SunriseSunsetCache.h"
+#include "SunriseSunsetTime.h"
+#include "../tests/Fixtures.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * every allocation made by the process is counted, to report allocations
+ * per operation
+ */
+namespace {
+std::atomic< size_t > g_allocations( 0 );
+}
+
+void* operator new( size_t size )
+{
+    g_allocations.fetch_add( 1, std::memory_order_relaxed );
+    void* p = std::malloc( size == 0 ? 1 : size );
+    if ( p == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete( void* p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+    std::free( p );
+}
+
+using namespace SGP4;
+
+namespace {
+
+struct Site
+{
+    const char* name;
+    double latitude;
+    double longitude;
+    double altitude;
+};
+
+const Site kSites[] = {
+    { "equator", 0.3, 32.6, 1.2 },
+    { "mid_latitude", 51.5, -0.1, 0.05 },
+    { "polar", 78.2, 15.6, 0.01 }
+};
+
+/*
+ * a thousand stations spread between the sites
+ */
+std::vector< CoordGeodetic > Stations()
+{
+    std::vector< CoordGeodetic > stations;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        const Site& site = kSites[i % 3];
+        stations.push_back( CoordGeodetic( site.latitude - i * 0.01, site.longitude + i * 0.3, site.altitude ) );
+    }
+    return stations;
+}
+
+/*
+ * a catalog of every fixture 64 times over
+ */
+std::vector< OrbitalElements > Catalog()
+{
+    std::vector< OrbitalElements > elements;
+    for ( int copy = 0; copy < 64; copy++ )
+    {
+        for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+        {
+            elements.push_back( OrbitalElements( Tle( satellite.line_one, satellite.line_two ) ) );
+        }
+    }
+    return elements;
+}
+
+/*
+ * results accumulate here so the compiler cannot drop the work
+ */
+volatile double g_sink = 0.0;
+
+struct Result
+{
+    std::string name;
+    uint64_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double items_per_op;
+};
+
+/**
+ * @brief Times functions of the iteration number for at least a minimum
+ * time each, doubling the iterations until the run is long enough.
+ */
+class Runner
+{
+public:
+    Runner( const std::string& filter, const double min_time )
+        : m_filter( filter )
+        , m_min_time( min_time )
+    {
+        std::printf( "%-52s %14s %14s %12s %12s\n",
+                "Benchmark", "ns/op", "items/s", "allocs/op", "Iterations" );
+    }
+
+    /*
+     * time f, which handles items things per call
+     */
+    template
+    <typename Function>
+    void Run( const std::string& name, const Function& f, const double items = 1.0 )
+    {
+        if ( !m_filter.empty() && name.find( m_filter ) == std::string::npos )
+        {
+            return;
+        }
+
+        g_sink = g_sink + f( 0 );
+
+        uint64_t iterations = 1;
+        double elapsed = 0.0;
+        size_t allocations = 0;
+        for ( ;; )
+        {
+            const size_t allocations_start = g_allocations.load();
+            const auto start = std::chrono::steady_clock::now();
+            double sum = 0.0;
+            for ( uint64_t i = 0; i < iterations; i++ )
+            {
+                sum += f( i );
+            }
+            const auto end = std::chrono::steady_clock::now();
+            g_sink = g_sink + sum;
+            allocations = g_allocations.load() - allocations_start;
+            elapsed = std::chrono::duration< double >( end - start ).count();
+
+            if ( elapsed >= m_min_time || iterations >= 1000000000 )
+            {
+                break;
+            }
+            /*
+             * aim past the minimum time, growing by at most a factor of 100
+             */
+            const double scale = elapsed > 0.0 ? 1.4 * m_min_time / elapsed : 100.0;
+            iterations = static_cast< uint64_t >( iterations
+                    * std::min( 100.0, std::max( 2.0, scale ) ) );
+        }
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.ns_per_op = elapsed * 1e9 / iterations;
+        result.allocs_per_op = static_cast< double >( allocations ) / iterations;
+        result.items_per_op = items;
+        m_results.push_back( result );
+
+        std::printf( "%-52s %14.1f %14.0f %12.2f %12llu\n",
+                name.c_str(), result.ns_per_op, items * 1e9 / result.ns_per_op,
+                result.allocs_per_op, static_cast< unsigned long long >( iterations ) );
+        std::fflush( stdout );
+    }
+
+    const std::vector< Result >& Results() const
+    {
+        return m_results;
+    }
+
+private:
+    std::string m_filter;
+    double m_min_time;
+    std::vector< Result > m_results;
+};
+
+void RunTleBenchmarks( Runner& runner )
+{
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const std::string line_one( satellite.line_one );
+        const std::string line_two( satellite.line_two );
+        runner.Run( std::string( "Tle/Parse/" ) + satellite.name,
+                [&]( uint64_t )
+                {
+                    const Tle tle( line_one, line_two );
+                    return tle.MeanMotion();
+                } );
+    }
+}
+
+/*
+ * a catalog of the fixtures repeated to count records, alternating three
+ * line and two line records
+ */
+std::string CatalogText( const size_t count )
+{
+    std::string text;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const Fixtures::Satellite& satellite = Fixtures::kSatellites[i % 4];
+        if ( i % 2 == 0 )
+        {
+            text += std::string( "SATELLITE " ) + std::to_string( i ) + "\n";
+        }
+        text += std::string( satellite.line_one ) + "\n" + satellite.line_two + "\n";
+    }
+    return text;
+}
+
+void RunCatalogBenchmarks( Runner& runner )
+{
+    static const size_t kRecords = 30000;
+    const std::string text = CatalogText( kRecords );
+
+    /*
+     * the whole catalog from memory, against the Tle constructor on the
+     * same lines one record at a time
+     */
+    runner.Run( "TleCatalogReader/Next/30000",
+            [&]( uint64_t )
+            {
+                TleCatalogReader reader( text.data(), text.size() );
+                TleRecord record;
+                double sum = 0.0;
+                while ( reader.Next( record ) )
+                {
+                    sum += record.mean_motion;
+                }
+                return sum;
+            },
+            static_cast< double >( kRecords ) );
+
+    std::vector< std::string > lines;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        lines.push_back( Fixtures::kSatellites[i].line_one );
+        lines.push_back( Fixtures::kSatellites[i].line_two );
+    }
+    const std::string name( "SATELLITE" );
+    runner.Run( "TleCatalogReader/Tle",
+            [&]( uint64_t i )
+            {
+                const Tle tle( name, lines[2 * ( i % 4 )], lines[2 * ( i % 4 ) + 1] );
+                return tle.MeanMotion();
+            } );
+
+    /*
+     * the whole catalog from a file, on every core
+     */
+    static const char* const kCatalogFile = "sgp4_benchmark_catalog.txt";
+    FILE* file = std::fopen( kCatalogFile, "wb" );
+    if ( file == nullptr )
+    {
+        return;
+    }
+    const bool written = std::fwrite( text.data(), 1, text.size(), file ) == text.size();
+    if ( std::fclose( file ) == 0 && written )
+    {
+        runner.Run( "TleCatalog/Load/30000",
+                []( uint64_t )
+                {
+                    const TleCatalog catalog( kCatalogFile );
+                    return static_cast< double >( catalog.Records().size() );
+                },
+                static_cast< double >( kRecords ) );
+    }
+    std::remove( kCatalogFile );
+}
+
+void RunSGP4Benchmarks( Runner& runner )
+{
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const SGP4::SGP4 sgp4( Tle( satellite.line_one, satellite.line_two ) );
+
+        /*
+         * a day of minutes since epoch, each integrated from epoch for deep
+         * space resonant orbits
+         */
+        runner.Run( std::string( "SGP4/FindPosition/" ) + satellite.name,
+                [&]( uint64_t i )
+                {
+                    return sgp4.FindPosition( static_cast< double >( i % 1440 ) ).Position().x;
+                } );
+
+        /*
+         * consecutive minutes, continuing from the previous call
+         */
+        SGP4::SGP4::PropagationContext context;
+        runner.Run( std::string( "SGP4/FindPositionContext/" ) + satellite.name,
+                [&]( uint64_t i )
+                {
+                    return sgp4.FindPosition( context, static_cast< double >( i % 1440 ) ).Position().x;
+                } );
+
+        /*
+         * a day of minutes in one call
+         */
+        std::vector< double > minutes( 1440 );
+        for ( size_t minute = 0; minute < minutes.size(); minute++ )
+        {
+            minutes[minute] = static_cast< double >( minute );
+        }
+        std::vector< Vector > positions( minutes.size() );
+        std::vector< Vector > velocities( minutes.size() );
+        runner.Run( std::string( "SGP4/FindPositions/1440/" ) + satellite.name,
+                [&]( uint64_t i )
+                {
+                    sgp4.FindPositions( minutes.data(), minutes.size(), positions.data(), velocities.data() );
+                    return positions[i % positions.size()].x;
+                } );
+    }
+
+    /*
+     * the catalog propagated together
+     */
+    const SatelliteBatch batch( Catalog() );
+    std::vector< Vector > positions( batch.Size() );
+    std::vector< Vector > velocities( batch.Size() );
+    std::vector< SatelliteBatch::Status > statuses( batch.Size() );
+    const DateTime epoch = Tle( Fixtures::kLeo.line_one, Fixtures::kLeo.line_two ).Epoch();
+    runner.Run( "SatelliteBatch/FindPositions/256",
+            [&]( uint64_t i )
+            {
+                batch.FindPositions( epoch.AddMinutes( static_cast< double >( i % 1440 ) ),
+                        positions.data(), velocities.data(), statuses.data() );
+                return positions[0].x;
+            } );
+}
+
+void RunCoordinateBenchmarks( Runner& runner )
+{
+    const DateTime start( 2024, 3, 20, 0, 0, 0 );
+
+    SolarPosition solar_position;
+    runner.Run( "SolarPosition/FindPosition",
+            [&]( uint64_t i )
+            {
+                return solar_position.FindPosition(
+                        start.AddMinutes( static_cast< double >( i % 525600 ) ) ).Position().x;
+            } );
+
+    const SolarEphemerisTable table( start, start.AddDays( 366.0 ) );
+    runner.Run( "SolarEphemerisTable/FindPosition",
+            [&]( uint64_t i )
+            {
+                return table.FindPosition(
+                        start.AddMinutes( static_cast< double >( i % 525600 ) ) ).Position().x;
+            } );
+
+    for ( const Site& site : kSites )
+    {
+        const CoordGeodetic geo( site.latitude, site.longitude, site.altitude );
+        runner.Run( std::string( "Eci/ToEci/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return Eci( start.AddMinutes( static_cast< double >( i % 1440 ) ), geo ).Position().x;
+                } );
+    }
+
+    const StationNetwork network( Stations() );
+    std::vector< Vector > positions( network.Size() );
+    std::vector< Vector > velocities( network.Size() );
+    runner.Run( "StationNetwork/FindPositions/1000",
+            [&]( uint64_t i )
+            {
+                network.FindPositions( start.AddMinutes( static_cast< double >( i % 1440 ) ),
+                        positions.data(), velocities.data() );
+                return positions[0].x;
+            } );
+
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const SGP4::SGP4 sgp4( Tle( satellite.line_one, satellite.line_two ) );
+        std::vector< Eci > track;
+        for ( int minute = 0; minute < 1440; minute += 10 )
+        {
+            track.push_back( sgp4.FindPosition( static_cast< double >( minute ) ) );
+        }
+        runner.Run( std::string( "Eci/ToGeodetic/" ) + satellite.name,
+                [&]( uint64_t i )
+                {
+                    return track[i % track.size()].ToGeodetic().latitude;
+                } );
+        runner.Run( std::string( "Eci/ToGeodeticBowring/" ) + satellite.name,
+                [&]( uint64_t i )
+                {
+                    return track[i % track.size()].ToGeodetic( Eci::GeodeticMethod::Bowring ).latitude;
+                } );
+
+        for ( const Site& site : kSites )
+        {
+            const Observer observer( site.latitude, site.longitude, site.altitude );
+            runner.Run( std::string( "Observer/GetLookAngle/" ) + site.name + "/" + satellite.name,
+                    [&]( uint64_t i )
+                    {
+                        return observer.GetLookAngle( track[i % track.size()] ).elevation;
+                    } );
+
+            /*
+             * the whole track of evenly spaced samples in one call
+             */
+            std::vector< CoordTopocentric > look_angles( track.size() );
+            runner.Run( std::string( "Observer/GetLookAngles/" ) + site.name + "/" + satellite.name,
+                    [&]( uint64_t i )
+                    {
+                        observer.GetLookAngles( track.data(), track.size(), look_angles.data() );
+                        return look_angles[i % track.size()].elevation;
+                    } );
+        }
+    }
+}
+
+void RunVisibilityBenchmarks( Runner& runner )
+{
+    const Tle tle( Fixtures::kLeo.line_one, Fixtures::kLeo.line_two );
+    const SGP4::SGP4 sgp4( tle );
+    const DateTime start = tle.Epoch();
+
+    /*
+     * the passes of a day, over consecutive days
+     */
+    for ( const Site& site : kSites )
+    {
+        const Observer observer( site.latitude, site.longitude, site.altitude );
+        runner.Run( std::string( "PassPredictor/FindPasses/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    const DateTime day = start.AddDays( static_cast< double >( i % 30 ) );
+                    return static_cast< double >( PassPredictor::FindPasses(
+                            sgp4, observer, day, day.AddDays( 1.0 ), 10.0 ).size() );
+                } );
+    }
+
+    VisibilityEngine engine( Catalog(), Stations(), 10.0 );
+    std::vector< Visibility > visible;
+    runner.Run( "VisibilityEngine/FindVisible/256x1000",
+            [&]( uint64_t i )
+            {
+                engine.FindVisible( start.AddMinutes( static_cast< double >( i % 1440 ) ), visible );
+                return static_cast< double >( visible.size() );
+            } );
+}
+
+void RunSunriseSunsetBenchmarks( Runner& runner )
+{
+    const DateTime start( 2024, 1, 1, 0, 0, 0 );
+
+    for ( const Site& site : kSites )
+    {
+        const Observer observer( site.latitude, site.longitude, site.altitude );
+
+        /*
+         * the month around the March equinox, when every site has a
+         * sunrise and a sunset
+         */
+        const DateTime equinox( 2024, 3, 6, 0, 0, 0 );
+        runner.Run( std::string( "SunriseSunset/getSunriseAndSunsetTime/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return static_cast< double >( getSunriseAndSunsetTime(
+                            equinox.AddDays( static_cast< double >( i % 30 ) ), observer ).first.Ticks() );
+                } );
+
+        runner.Run( std::string( "SunriseSunset/getSunriseSunset/Scan/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return static_cast< double >( getSunriseSunset(
+                            start.AddDays( static_cast< double >( i % 366 ) ), observer,
+                            SunriseSunsetMethod::Scan ).sunrise.Ticks() );
+                } );
+
+        runner.Run( std::string( "SunriseSunset/getSunriseSunset/HourAngle/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return static_cast< double >( getSunriseSunset(
+                            start.AddDays( static_cast< double >( i % 366 ) ), observer,
+                            SunriseSunsetMethod::HourAngle ).sunrise.Ticks() );
+                } );
+
+        runner.Run( std::string( "SunriseSunset/getSolarDay/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return getSolarDay( start.AddDays( static_cast< double >( i % 366 ) ),
+                            observer ).transitElevation;
+                } );
+
+        /*
+         * a year of days in one call
+         */
+        runner.Run( std::string( "SunriseSunset/getSunriseSunsetCalendar/366/" ) + site.name,
+                [&]( uint64_t )
+                {
+                    return static_cast< double >( getSunriseSunsetCalendar(
+                            observer, start, start.AddDays( 365.0 ) ).back().sunrise.Ticks() );
+                } );
+
+        /*
+         * a month of days that stay cached, and days never asked for
+         * before
+         */
+        SunriseSunsetCache cache;
+        runner.Run( std::string( "SunriseSunsetCache/get/Hit/" ) + site.name,
+                [&]( uint64_t i )
+                {
+                    return static_cast< double >( cache.get(
+                            start.AddDays( static_cast< double >( i % 30 ) ), observer ).sunrise.Ticks() );
+                } );
+        /*
+         * the runner repeats iteration numbers, so the days come from a
+         * counter of their own
+         */
+        uint64_t next_day = 30;
+        runner.Run( std::string( "SunriseSunsetCache/get/Miss/" ) + site.name,
+                [&]( uint64_t )
+                {
+                    const double day = static_cast< double >( next_day++ % 1000000 );
+                    return static_cast< double >( cache.get( start.AddDays( day ), observer ).sunrise.Ticks() );
+                } );
+    }
+
+    /*
+     * every station on one day, sharing one solar track
+     */
+    const std::vector< CoordGeodetic > stations = Stations();
+    std::vector< DateTime > sunrises( stations.size() );
+    std::vector< DateTime > sunsets( stations.size() );
+    std::vector< SunriseSunsetStatus > statuses( stations.size() );
+    runner.Run( "SunriseSunset/getSunriseAndSunsetTimeBatch/1000",
+            [&]( uint64_t i )
+            {
+                getSunriseAndSunsetTimeBatch( start.AddDays( static_cast< double >( i % 366 ) ),
+                        stations.data(), stations.size(), sunrises.data(), sunsets.data(), statuses.data() );
+                return static_cast< double >( sunrises[0].Ticks() );
+            } );
+}
+
+bool WriteJson( const std::string& path, const std::vector< Result >& results )
+{
+    FILE* file = std::fopen( path.c_str(), "w" );
+    if ( file == nullptr )
+    {
+        return false;
+    }
+
+    char date[64];
+    const std::time_t now = std::time( nullptr );
+    std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::gmtime( &now ) );
+
+    std::fprintf( file, "{\n" );
+    std::fprintf( file, "  \"context\": {\n" );
+    std::fprintf( file, "    \"date\": \"%s\",\n", date );
+    std::fprintf( file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency() );
+#ifdef NDEBUG
+    std::fprintf( file, "    \"library_build_type\": \"release\"\n" );
+#else
+    std::fprintf( file, "    \"library_build_type\": \"debug\"\n" );
+#endif
+    std::fprintf( file, "  },\n" );
+    std::fprintf( file, "  \"benchmarks\": [\n" );
+    for ( size_t i = 0; i < results.size(); i++ )
+    {
+        const Result& result = results[i];
+        std::fprintf( file, "    {\n" );
+        std::fprintf( file, "      \"name\": \"%s\",\n", result.name.c_str() );
+        std::fprintf( file, "      \"iterations\": %llu,\n",
+                static_cast< unsigned long long >( result.iterations ) );
+        std::fprintf( file, "      \"real_time\": %.3f,\n", result.ns_per_op );
+        std::fprintf( file, "      \"time_unit\": \"ns\",\n" );
+        std::fprintf( file, "      \"items_per_second\": %.3f,\n",
+                result.items_per_op * 1e9 / result.ns_per_op );
+        std::fprintf( file, "      \"allocs_per_iteration\": %.4f\n", result.allocs_per_op );
+        std::fprintf( file, "    }%s\n", i + 1 < results.size() ? "," : "" );
+    }
+    std::fprintf( file, "  ]\n" );
+    std::fprintf( file, "}\n" );
+
+    return std::fclose( file ) == 0;
+}
+
+void Usage( const char* program )
+{
+    std::fprintf( stderr,
+            "usage: %s [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]"
+            " [--benchmark_out=<file.json>]\n", program );
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+    std::string filter;
+    double min_time = 0.5;
+    std::string out;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const std::string arg( argv[i] );
+        const size_t equals = arg.find( '=' );
+        const std::string key = arg.substr( 0, equals );
+        const std::string value = equals == std::string::npos ? std::string() : arg.substr( equals + 1 );
+        if ( key == "--benchmark_filter" )
+        {
+            filter = value;
+        }
+        else if ( key == "--benchmark_min_time" )
+        {
+            min_time = std::atof( value.c_str() );
+        }
+        else if ( key == "--benchmark_out" )
+        {
+            out = value;
+        }
+        else
+        {
+            Usage( argv[0] );
+            return 1;
+        }
+    }
+
+    Runner runner( filter, min_time );
+    RunTleBenchmarks( runner );
+    RunCatalogBenchmarks( runner );
+    RunSGP4Benchmarks( runner );
+    RunCoordinateBenchmarks( runner );
+    RunVisibilityBenchmarks( runner );
+    RunSunriseSunsetBenchmarks( runner );
+
+    if ( !out.empty() && !WriteJson( out, runner.Results() ) )
+    {
+        std::fprintf( stderr, "could not write %s\n", out.c_str() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include "Fixtures.h"
+#include "Test.h"
+
+#include <SGP4/Tle.h>
+#include <SGP4/TleCatalog.h>
+#include <SGP4/TleCatalogReader.h>
+#include <SGP4/TleException.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace SGP4;
+
+namespace {
+const char* const kCatalogFile = "sgp4_tests_catalog.txt";
+
+/*
+ * what the Tle constructor and the catalog reader make of one record, either
+ * the decoded fields or the error message
+ */
+struct Outcome
+{
+    std::string reason;
+    TleRecord record;
+};
+
+Outcome FromTle( const std::string& line_one, const std::string& line_two )
+{
+    Outcome outcome = Outcome();
+    try
+    {
+        const Tle tle( line_one, line_two );
+        TleRecord& record = outcome.record;
+        record.norad_number = tle.NoradNumber();
+        record.orbit_number = tle.OrbitNumber();
+        record.epoch = tle.Epoch();
+        record.mean_motion_dt2 = tle.MeanMotionDt2();
+        record.mean_motion_ddt6 = tle.MeanMotionDdt6();
+        record.bstar = tle.BStar();
+        record.inclination = tle.Inclination( true );
+        record.right_ascending_node = tle.RightAscendingNode( true );
+        record.eccentricity = tle.Eccentricity();
+        record.argument_perigee = tle.ArgumentPerigee( true );
+        record.mean_anomaly = tle.MeanAnomaly( true );
+        record.mean_motion = tle.MeanMotion();
+        const std::string designator = tle.IntDesignator();
+        record.int_designator[ designator.copy( record.int_designator,
+                sizeof( record.int_designator ) - 1 ) ] = '\0';
+    }
+    catch ( TleException& e )
+    {
+        outcome.reason = e.what();
+    }
+    return outcome;
+}
+
+Outcome FromReader( TleCatalogReader& reader )
+{
+    Outcome outcome = Outcome();
+    try
+    {
+        if ( !reader.Next( outcome.record ) )
+        {
+            outcome.reason = "end";
+        }
+    }
+    catch ( TleException& e )
+    {
+        outcome.reason = e.what();
+    }
+    return outcome;
+}
+
+bool SameOutcome( const Outcome& a, const Outcome& b )
+{
+    if ( a.reason != b.reason )
+    {
+        return false;
+    }
+    if ( !a.reason.empty() )
+    {
+        return true;
+    }
+    const TleRecord& x = a.record;
+    const TleRecord& y = b.record;
+    return std::string( x.int_designator ) == y.int_designator
+        && x.norad_number == y.norad_number
+        && x.orbit_number == y.orbit_number
+        && x.epoch.Ticks() == y.epoch.Ticks()
+        && x.mean_motion_dt2 == y.mean_motion_dt2
+        && x.mean_motion_ddt6 == y.mean_motion_ddt6
+        && x.bstar == y.bstar
+        && x.inclination == y.inclination
+        && x.right_ascending_node == y.right_ascending_node
+        && x.eccentricity == y.eccentricity
+        && x.argument_perigee == y.argument_perigee
+        && x.mean_anomaly == y.mean_anomaly
+        && x.mean_motion == y.mean_motion;
+}
+
+/*
+ * read text holding one record followed by the leo fixture, check the first
+ * matches the Tle constructor and the reader recovers for the second
+ */
+bool ReaderMatchesTle( const std::string& text,
+        const std::string& line_one,
+        const std::string& line_two )
+{
+    const std::string catalog = text
+        + Fixtures::kLeo.line_one + "\n"
+        + Fixtures::kLeo.line_two + "\n";
+    TleCatalogReader reader( catalog.data(), catalog.size() );
+    const bool same = SameOutcome( FromReader( reader ), FromTle( line_one, line_two ) );
+    const Outcome next = FromReader( reader );
+    return same && next.reason.empty() && next.record.norad_number == 28057
+        && FromReader( reader ).reason == "end";
+}
+
+/*
+ * a catalog of the fixtures where most records are damaged, in ways that
+ * change how the lines around them group into records
+ */
+std::string DamagedCatalog( const size_t count )
+{
+    std::string text;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const Fixtures::Satellite& satellite = Fixtures::kSatellites[ i % 4 ];
+        const std::string name = std::string( "SATELLITE " ) + std::to_string( i ) + "\n";
+        const std::string line_one = std::string( satellite.line_one ) + "\n";
+        const std::string line_two = std::string( satellite.line_two ) + "\n";
+        switch ( i % 9 )
+        {
+        case 0:
+            /* line two missing, so the next name is read as line two */
+            text += name + line_one;
+            break;
+        case 1:
+            text += name + line_one + line_two;
+            break;
+        case 2:
+            text += line_one + line_two;
+            break;
+        case 3:
+            /* line one cut short */
+            text += name + line_one.substr( 0, 40 ) + "\n" + line_two;
+            break;
+        case 4:
+            /* line one missing */
+            text += line_two;
+            break;
+        case 5:
+            /* line one not starting with 1, read as a damaged line one */
+            text += "X" + line_one.substr( 1 ) + line_two;
+            break;
+        case 6:
+            text += name.substr( 0, name.size() - 1 ) + "\r\n\r\n"
+                + line_one.substr( 0, line_one.size() - 1 ) + "\r\n\n"
+                + line_two;
+            break;
+        case 7:
+            /* both lines missing */
+            text += name;
+            break;
+        default:
+            /* a name of a line two's length */
+            text += "2" + std::string( Tle::LineLength() - 1, ' ' ) + "\n"
+                + line_one + line_two;
+            break;
+        }
+    }
+    return text;
+}
+
+bool SameRecord( const TleRecord& a, const TleRecord& b )
+{
+    Outcome x;
+    Outcome y;
+    x.record = a;
+    y.record = b;
+    return std::strcmp( a.name, b.name ) == 0 && SameOutcome( x, y );
+}
+} //namespace
+
+TEST( CatalogReaderMatchesTle )
+{
+    std::string catalog;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        const Fixtures::Satellite& satellite = Fixtures::kSatellites[i];
+        if ( i % 2 == 0 )
+        {
+            catalog += std::string( satellite.name ) + "   \r\n";
+        }
+        catalog += std::string( satellite.line_one ) + "\r\n"
+            + satellite.line_two + "\r\n\r\n";
+    }
+
+    TleCatalogReader reader( catalog.data(), catalog.size() );
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        const Fixtures::Satellite& satellite = Fixtures::kSatellites[i];
+        const Outcome outcome = FromReader( reader );
+        CHECK( SameOutcome( outcome, FromTle( satellite.line_one, satellite.line_two ) ) );
+        const Tle tle( satellite.line_one, satellite.line_two );
+        CHECK( outcome.record.name == ( i % 2 == 0 ? satellite.name : tle.Name() ) );
+    }
+    CHECK( FromReader( reader ).reason == "end" );
+}
+
+TEST( CatalogReaderMatchesTleOnDamagedLines )
+{
+    const char replacements[] = "X -+.0";
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        for ( size_t line = 0; line < 2; line++ )
+        {
+            for ( size_t column = 0; column < Tle::LineLength(); column++ )
+            {
+                for ( size_t r = 0; replacements[r] != '\0'; r++ )
+                {
+                    std::string line_one = satellite.line_one;
+                    std::string line_two = satellite.line_two;
+                    ( line == 0 ? line_one : line_two )[ column ] = replacements[r];
+
+                    CHECK( ReaderMatchesTle( line_one + "\n" + line_two + "\n",
+                                line_one, line_two ) );
+                    CHECK( ReaderMatchesTle( std::string( satellite.name ) + "\n"
+                                + line_one + "\n" + line_two + "\n",
+                                line_one, line_two ) );
+                }
+            }
+        }
+    }
+}
+
+TEST( CatalogReaderMatchesTleOnTruncatedLines )
+{
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const std::string name( satellite.name );
+        const std::string line_one( satellite.line_one );
+        const std::string line_two( satellite.line_two );
+
+        /*
+         * an empty line is skipped rather than read as a short line
+         */
+        for ( size_t length = 1; length < Tle::LineLength(); length++ )
+        {
+            const std::string short_one = line_one.substr( 0, length );
+            const std::string short_two = line_two.substr( 0, length );
+            CHECK( ReaderMatchesTle( name + "\n" + short_one + "\n" + line_two + "\n",
+                        short_one, line_two ) );
+            CHECK( ReaderMatchesTle( name + "\n" + line_one + "\n" + short_two + "\n",
+                        line_one, short_two ) );
+            CHECK( ReaderMatchesTle( line_one + "\n" + short_two + "\n",
+                        line_one, short_two ) );
+            CHECK( ReaderMatchesTle( short_one + "\n" + line_two + "\n",
+                        short_one, line_two ) );
+        }
+
+        const std::string truncated[] = {
+            name + "\n",
+            line_one + "\n",
+            name + "\n" + line_one,
+        };
+        for ( const std::string& text : truncated )
+        {
+            TleCatalogReader reader( text.data(), text.size() );
+            CHECK( FromReader( reader ).reason == "Unexpected end of catalog" );
+            CHECK( FromReader( reader ).reason == "end" );
+        }
+    }
+}
+
+TEST( CatalogLoadMatchesSerialRead )
+{
+    const std::string text = DamagedCatalog( 20000 );
+    {
+        std::ofstream file( kCatalogFile, std::ios::binary );
+        file << text;
+    }
+
+    std::vector< TleRecord > records;
+    std::vector< TleCatalogError > errors;
+    TleCatalogReader reader( text.data(), text.size() );
+    TleRecord record;
+    TleCatalogError error;
+    while ( reader.Next( record, error.field, error.reason ) )
+    {
+        if ( error.reason )
+        {
+            error.line = reader.LineNumber();
+            errors.push_back( error );
+        }
+        else
+        {
+            records.push_back( record );
+        }
+    }
+    CHECK( records.size() > 0 && errors.size() > 0 );
+
+    const unsigned int threads[] = { 1, 2, 3, 5, 8 };
+    for ( const unsigned int count : threads )
+    {
+        const TleCatalog catalog( kCatalogFile, count );
+        CHECK( catalog.Records().size() == records.size() );
+        CHECK( catalog.Errors().size() == errors.size() );
+        if ( catalog.Records().size() != records.size()
+                || catalog.Errors().size() != errors.size() )
+        {
+            continue;
+        }
+
+        size_t records_differing = 0;
+        for ( size_t i = 0; i < records.size(); i++ )
+        {
+            records_differing += SameRecord( catalog.Records()[i], records[i] ) ? 0 : 1;
+        }
+        CHECK( records_differing == 0 );
+
+        size_t errors_differing = 0;
+        for ( size_t i = 0; i < errors.size(); i++ )
+        {
+            const TleCatalogError& a = catalog.Errors()[i];
+            const TleCatalogError& b = errors[i];
+            errors_differing += a.line == b.line
+                && std::strcmp( a.field, b.field ) == 0
+                && std::strcmp( a.reason, b.reason ) == 0 ? 0 : 1;
+        }
+        CHECK( errors_differing == 0 );
+    }
+
+    std::remove( kCatalogFile );
+}
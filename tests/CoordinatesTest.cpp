@@ -0,0 +1,182 @@
+#include "Fixtures.h"
+#include "Test.h"
+
+#include <SGP4/CoordGeodetic.h>
+#include <SGP4/CoordTopocentric.h>
+#include <SGP4/EarthOrientation.h>
+#include <SGP4/Eci.h>
+#include <SGP4/Globals.h>
+#include <SGP4/Observer.h>
+#include <SGP4/SGP4.h>
+#include <SGP4/StationNetwork.h>
+#include <SGP4/Tle.h>
+#include <SGP4/Util.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace SGP4;
+
+namespace {
+/*
+ * locations from pole to pole and from below the surface to beyond
+ * geosynchronous altitude
+ */
+std::vector< CoordGeodetic > Locations()
+{
+    std::vector< CoordGeodetic > locations;
+    const double altitudes[] = { -0.4, 0.0, 2.5, 400.0, 20200.0, 35786.0, 50000.0 };
+    for ( double latitude = -90.0; latitude <= 90.0; latitude += 7.5 )
+    {
+        for ( double longitude = -180.0; longitude < 180.0; longitude += 45.0 )
+        {
+            for ( const double altitude : altitudes )
+            {
+                locations.push_back( CoordGeodetic( latitude, longitude + latitude / 7.0, altitude ) );
+            }
+        }
+    }
+    locations.push_back( CoordGeodetic( 90.0 - 1e-9, 10.0, 100.0 ) );
+    locations.push_back( CoordGeodetic( -90.0 + 1e-9, 10.0, 100.0 ) );
+    return locations;
+}
+
+double AngleBetween( const double a, const double b )
+{
+    return fabs( Util::WrapNegPosPI( a - b ) );
+}
+
+void CheckLookAngle( const CoordTopocentric& actual, const CoordTopocentric& expected )
+{
+    /*
+     * the azimuth is undefined at the zenith
+     */
+    if ( expected.elevation < kPI / 2.0 - 1e-6 )
+    {
+        CHECK_NEAR( AngleBetween( actual.azimuth, expected.azimuth ) * cos( expected.elevation ), 0.0, 5e-8 );
+    }
+    CHECK_NEAR( actual.elevation, expected.elevation, 5e-8 );
+    CHECK_NEAR( actual.range, expected.range, 5e-5 );
+    CHECK_NEAR( actual.range_rate, expected.range_rate, 1e-7 );
+}
+}
+
+TEST( ToGeodeticRoundTrip )
+{
+    const DateTime dt( 2024, 3, 20, 12, 0, 0 );
+    for ( const CoordGeodetic& geo : Locations() )
+    {
+        const CoordGeodetic result = Eci( dt, geo ).ToGeodetic();
+        CHECK_NEAR( result.latitude, geo.latitude, 1e-9 );
+        CHECK_NEAR( result.altitude, geo.altitude, 1e-6 );
+    }
+}
+
+TEST( BowringMatchesIterative )
+{
+    const DateTime dt( 2024, 3, 20, 12, 0, 0 );
+    const EarthOrientation orientation( dt );
+    const std::vector< CoordGeodetic > locations = Locations();
+
+    std::vector< Vector > positions;
+    for ( const CoordGeodetic& geo : locations )
+    {
+        const Eci eci( dt, geo );
+        positions.push_back( eci.Position() );
+
+        const CoordGeodetic iterative = eci.ToGeodetic( orientation );
+        const CoordGeodetic bowring = eci.ToGeodetic( orientation, Eci::GeodeticMethod::Bowring );
+        CHECK_NEAR( bowring.latitude, iterative.latitude, 2e-12 );
+        CHECK_NEAR( AngleBetween( bowring.longitude, iterative.longitude ), 0.0, 1e-12 );
+        CHECK_NEAR( bowring.altitude, iterative.altitude, 1e-9 );
+    }
+
+    std::vector< CoordGeodetic > batch( positions.size() );
+    Eci::ToGeodetic( orientation, positions.data(), positions.size(), batch.data() );
+    for ( size_t i = 0; i < positions.size(); i++ )
+    {
+        CHECK( batch[i] == Eci( dt, positions[i] ).ToGeodetic( orientation ) );
+    }
+
+    Eci::ToGeodetic( orientation, positions.data(), positions.size(), batch.data(),
+            Eci::GeodeticMethod::Bowring );
+    for ( size_t i = 0; i < positions.size(); i++ )
+    {
+        const CoordGeodetic bowring = Eci( dt, positions[i] ).ToGeodetic(
+                orientation, Eci::GeodeticMethod::Bowring );
+        CHECK( batch[i] == bowring );
+    }
+}
+
+TEST( StationNetworkMatchesToEci )
+{
+    const std::vector< CoordGeodetic > stations = Locations();
+    const StationNetwork network( stations );
+    std::vector< Vector > positions( network.Size() );
+    std::vector< Vector > velocities( network.Size() );
+    std::vector< double > x( network.Size() );
+    std::vector< double > y( network.Size() );
+    std::vector< double > z( network.Size() );
+    std::vector< double > vx( network.Size() );
+    std::vector< double > vy( network.Size() );
+    std::vector< double > vz( network.Size() );
+
+    for ( int step = 0; step < 5; step++ )
+    {
+        const DateTime dt = DateTime( 2024, 1, 1, 0, 0, 0 ).AddMinutes( step * 317.3 );
+        network.FindPositions( dt, positions.data(), velocities.data() );
+        network.FindPositions( EarthOrientation( dt ), x.data(), y.data(), z.data(),
+                vx.data(), vy.data(), vz.data() );
+
+        for ( size_t i = 0; i < stations.size(); i++ )
+        {
+            const Eci eci( dt, stations[i] );
+            CHECK_NEAR( ( positions[i] - eci.Position() ).Magnitude(), 0.0, 1e-10 );
+            CHECK_NEAR( ( velocities[i] - eci.Velocity() ).Magnitude(), 0.0, 1e-14 );
+            CHECK_NEAR( positions[i].w, eci.Position().w, 1e-10 );
+            CHECK( x[i] == positions[i].x && y[i] == positions[i].y && z[i] == positions[i].z );
+            CHECK( vx[i] == velocities[i].x && vy[i] == velocities[i].y && vz[i] == velocities[i].z );
+        }
+    }
+}
+
+TEST( GetLookAnglesMatchesGetLookAngle )
+{
+    const Observer observers[] = {
+        Observer( 0.3, 32.6, 1.2 ),
+        Observer( 51.5, -0.1, 0.05 ),
+        Observer( 78.2, 15.6, 0.01 ),
+        Observer( -89.9, -170.0, 2.0 ) };
+    const double steps[] = { 0.001, 1.0, 60.0, 3600.0 };
+
+    for ( const Fixtures::Satellite& satellite : { Fixtures::kLeo, Fixtures::kMolniya } )
+    {
+        const SGP4::SGP4 sgp4( Tle( satellite.line_one, satellite.line_two ) );
+        for ( const double step : steps )
+        {
+            /*
+             * an evenly spaced track, then one that is not
+             */
+            std::vector< Eci > uniform;
+            std::vector< Eci > uneven;
+            for ( int i = 0; i < 300; i++ )
+            {
+                uniform.push_back( sgp4.FindPosition( step * i / 60.0 ) );
+                uneven.push_back( sgp4.FindPosition( step * i * i / 6000.0 ) );
+            }
+
+            for ( const Observer& observer : observers )
+            {
+                for ( const std::vector< Eci >* track : { &uniform, &uneven } )
+                {
+                    std::vector< CoordTopocentric > look_angles( track->size() );
+                    observer.GetLookAngles( track->data(), track->size(), look_angles.data() );
+                    for ( size_t i = 0; i < track->size(); i++ )
+                    {
+                        CheckLookAngle( look_angles[i], observer.GetLookAngle( ( *track )[i] ) );
+                    }
+                }
+            }
+        }
+    }
+}
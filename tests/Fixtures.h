@@ -0,0 +1,39 @@
+#ifndef FIXTURES_H_
+#define FIXTURES_H_
+
+/*
+ * elements shared by the tests and the benchmark: a near space orbit, a
+ * geosynchronous orbit with one day resonance, and two eccentric deep
+ * space orbits of about twelve hours with half day resonance
+ */
+namespace Fixtures {
+
+struct Satellite
+{
+    const char* name;
+    const char* line_one;
+    const char* line_two;
+};
+
+const Satellite kLeo = {
+    "leo",
+    "1 28057U 03049A   06177.78615833  .00000060  00000-0  35940-4 0  1836",
+    "2 28057  98.4283 247.6961 0000884  88.1964 272.0417 14.34984448141798" };
+const Satellite kGeo = {
+    "geo",
+    "1 28626U 05008A   06176.46683397 -.00000205  00000-0  10000-3 0  2190",
+    "2 28626   0.0019 286.9433 0000335  13.7918  55.6504  1.00270176  4891" };
+const Satellite kMolniya = {
+    "molniya",
+    "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+    "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656" };
+const Satellite kResonant = {
+    "resonant",
+    "1 22674U 93035D   06176.55909107  .00000069  00000-0  10000-3 0  6062",
+    "2 22674  63.5035 354.4452 7541712 253.3264  18.7754  1.96679808 93877" };
+
+const Satellite kSatellites[] = { kLeo, kGeo, kMolniya, kResonant };
+
+} //namespace Fixtures
+
+#endif
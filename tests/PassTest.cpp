@@ -0,0 +1,213 @@
+#include "Fixtures.h"
+#include "Test.h"
+
+#include <SGP4/CoordGeodetic.h>
+#include <SGP4/CoordTopocentric.h>
+#include <SGP4/DateTime.h>
+#include <SGP4/Observer.h>
+#include <SGP4/OrbitalElements.h>
+#include <SGP4/PassPredictor.h>
+#include <SGP4/SGP4.h>
+#include <SGP4/Tle.h>
+#include <SGP4/Util.h>
+#include <SGP4/VisibilityEngine.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace SGP4;
+
+namespace {
+/*
+ * the passes of a second by second scan of the elevation, each bounded by
+ * its first and last second in view
+ */
+struct ScannedPass
+{
+    DateTime aos;
+    DateTime los;
+    double max_elevation;
+};
+
+/*
+ * the elevation in degrees at each second from start to end
+ */
+std::vector< double > Elevations( const SGP4::SGP4& sgp4,
+        const Observer& observer,
+        const DateTime& start,
+        const DateTime& end )
+{
+    std::vector< double > elevations;
+    SGP4::SGP4::PropagationContext context;
+    for ( DateTime dt = start; dt <= end; dt = dt.AddSeconds( 1.0 ) )
+    {
+        elevations.push_back( Util::RadiansToDegrees(
+                    observer.GetLookAngle( sgp4.FindPosition( context, dt ) ).elevation ) );
+    }
+    return elevations;
+}
+
+std::vector< ScannedPass > ScanPasses( const std::vector< double >& elevations,
+        const DateTime& start,
+        const double min_elevation )
+{
+    std::vector< ScannedPass > passes;
+    bool in_view = false;
+    for ( size_t i = 0; i < elevations.size(); i++ )
+    {
+        if ( elevations[i] >= min_elevation )
+        {
+            const DateTime dt = start.AddSeconds( static_cast< double >( i ) );
+            if ( !in_view )
+            {
+                passes.push_back( ScannedPass{ dt, dt, elevations[i] } );
+                in_view = true;
+            }
+            passes.back().los = dt;
+            passes.back().max_elevation = std::max( passes.back().max_elevation, elevations[i] );
+        }
+        else
+        {
+            in_view = false;
+        }
+    }
+    return passes;
+}
+} //namespace
+
+/*
+ * every pass of a one second scan is found, with its crossings within the
+ * second the scan brackets them to
+ */
+TEST( PassPredictorMatchesScan )
+{
+    const Observer observers[] = {
+        Observer( 51.5, -0.1, 0.05 ),
+        Observer( -33.9, 151.2, 0.0 ),
+        Observer( 78.2, 15.6, 0.5 ),
+    };
+    const double min_elevations[] = { 0.0, 10.0 };
+
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const Tle tle( satellite.line_one, satellite.line_two );
+        const SGP4::SGP4 sgp4( tle );
+        const DateTime start = tle.Epoch();
+        const DateTime end = start.AddDays( 2.0 );
+        for ( const Observer& observer : observers )
+        {
+            const std::vector< double > elevations = Elevations( sgp4, observer, start, end );
+            for ( const double min_elevation : min_elevations )
+            {
+                const std::vector< PassDetails > passes = PassPredictor::FindPasses(
+                        sgp4, observer, start, end, min_elevation );
+                const std::vector< ScannedPass > scanned = ScanPasses(
+                        elevations, start, min_elevation );
+                CHECK( passes.size() == scanned.size() );
+                if ( passes.size() != scanned.size() )
+                {
+                    continue;
+                }
+
+                for ( size_t i = 0; i < passes.size(); i++ )
+                {
+                    const PassDetails& pass = passes[i];
+                    CHECK( pass.aos <= scanned[i].aos );
+                    CHECK( pass.los >= scanned[i].los );
+                    CHECK( ( scanned[i].aos - pass.aos ).TotalSeconds() < 1.0 );
+                    CHECK( ( pass.los - scanned[i].los ).TotalSeconds() < 1.0 );
+                    CHECK( pass.max_elevation_time >= pass.aos );
+                    CHECK( pass.max_elevation_time <= pass.los );
+
+                    const double max_elevation = Util::RadiansToDegrees(
+                            pass.max_elevation_look_angle.elevation );
+                    /*
+                     * the scan can only fall short of the highest elevation,
+                     * by up to a few hundredths of a degree on an overhead
+                     * pass, the predictor by the tenth of a second it finds
+                     * the time to
+                     */
+                    CHECK( max_elevation >= scanned[i].max_elevation - 1e-6 );
+                    CHECK_NEAR( max_elevation, scanned[i].max_elevation, 0.05 );
+                }
+            }
+        }
+    }
+}
+
+/*
+ * the engine finds the pairs that testing every satellite from every
+ * station with GetLookAngle does, with the same look angles
+ */
+TEST( VisibilityEngineMatchesLookAngles )
+{
+    const double min_elevation = 5.0;
+    std::vector< OrbitalElements > satellites;
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        satellites.push_back( OrbitalElements( Tle( satellite.line_one, satellite.line_two ) ) );
+    }
+
+    std::vector< CoordGeodetic > stations;
+    for ( double latitude = -85.0; latitude <= 85.0; latitude += 10.0 )
+    {
+        for ( double longitude = -180.0; longitude < 180.0; longitude += 7.5 )
+        {
+            stations.push_back( CoordGeodetic( latitude, longitude, 0.2 ) );
+        }
+    }
+
+    VisibilityEngine engine( satellites, stations, min_elevation );
+    const DateTime start = satellites[0].Epoch();
+    size_t found = 0;
+    for ( int step = 0; step < 48; step++ )
+    {
+        const DateTime dt = start.AddMinutes( step * 31.0 );
+        std::vector< Visibility > visible;
+        engine.FindVisible( dt, visible );
+
+        std::vector< Visibility > expected;
+        size_t borderline = 0;
+        for ( size_t s = 0; s < satellites.size(); s++ )
+        {
+            const Eci eci = SGP4::SGP4( satellites[s] ).FindPosition( dt );
+            for ( size_t o = 0; o < stations.size(); o++ )
+            {
+                const CoordTopocentric look_angle = Observer( stations[o] ).GetLookAngle( eci );
+                const double elevation = Util::RadiansToDegrees( look_angle.elevation );
+                if ( elevation >= min_elevation )
+                {
+                    expected.push_back( Visibility{ s, o, look_angle } );
+                }
+                borderline += std::fabs( elevation - min_elevation ) < 1e-6 ? 1 : 0;
+            }
+        }
+
+        CHECK( borderline == 0 );
+        CHECK( visible.size() == expected.size() );
+        if ( visible.size() != expected.size() )
+        {
+            continue;
+        }
+
+        /*
+         * stations of a satellite come in cell order, so sort them
+         */
+        auto by_pair = []( const Visibility& a, const Visibility& b )
+        {
+            return a.satellite != b.satellite ? a.satellite < b.satellite : a.station < b.station;
+        };
+        std::sort( visible.begin(), visible.end(), by_pair );
+        for ( size_t i = 0; i < visible.size(); i++ )
+        {
+            CHECK( visible[i].satellite == expected[i].satellite );
+            CHECK( visible[i].station == expected[i].station );
+            CHECK_NEAR( visible[i].look_angle.elevation, expected[i].look_angle.elevation, 1e-9 );
+            CHECK_NEAR( visible[i].look_angle.azimuth, expected[i].look_angle.azimuth, 1e-9 );
+            CHECK_NEAR( visible[i].look_angle.range, expected[i].look_angle.range, 1e-6 );
+        }
+        found += visible.size();
+    }
+    CHECK( found > 1000 );
+}
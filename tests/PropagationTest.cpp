@@ -0,0 +1,335 @@
+#include "Fixtures.h"
+#include "Test.h"
+
+#include <SGP4/DecayedException.h>
+#include <SGP4/OrbitalElements.h>
+#include <SGP4/SGP4.h>
+#include <SGP4/SatelliteBatch.h>
+#include <SGP4/Tle.h>
+#include <SGP4/TleException.h>
+#include <SGP4/TleSnapshot.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace SGP4;
+
+namespace {
+const char* const kSnapshotFile = "sgp4_tests_snapshot.bin";
+
+/*
+ * where the snapshot header keeps its count and array offsets
+ */
+const size_t kCountField = 32;
+const size_t kRecordsOffsetField = 40;
+const size_t kStatesOffsetField = 48;
+
+bool SamePosition( const Eci& a, const Eci& b )
+{
+    return a.Position() == b.Position() && a.Velocity() == b.Velocity();
+}
+
+TleRecord Record( const Fixtures::Satellite& satellite )
+{
+    TleRecord record;
+    const char* field = nullptr;
+    const char* reason = Tle::Parse( satellite.line_one, std::strlen( satellite.line_one ),
+                                     satellite.line_two, std::strlen( satellite.line_two ),
+                                     record, field );
+    CHECK( reason == nullptr );
+    return record;
+}
+
+std::vector< TleRecord > Records()
+{
+    std::vector< TleRecord > records;
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        records.push_back( Record( satellite ) );
+    }
+    return records;
+}
+
+std::string ReadFile( const char* filename )
+{
+    std::ifstream file( filename, std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+}
+
+void WriteFile( const char* filename, const std::string& data )
+{
+    std::ofstream file( filename, std::ios::binary | std::ios::trunc );
+    file.write( data.data(), static_cast< std::streamsize >( data.size() ) );
+}
+
+uint64_t Field( const std::string& data, const size_t offset )
+{
+    uint64_t value;
+    std::memcpy( &value, data.data() + offset, sizeof( value ) );
+    return value;
+}
+
+std::string WithField( std::string data, const size_t offset, const uint64_t value )
+{
+    std::memcpy( &data[offset], &value, sizeof( value ) );
+    return data;
+}
+
+bool Rejected( const std::string& data )
+{
+    WriteFile( kSnapshotFile, data );
+    try
+    {
+        TleSnapshot snapshot( kSnapshotFile );
+    }
+    catch ( TleException& )
+    {
+        return true;
+    }
+    return false;
+}
+}
+
+/*
+ * continuing the resonance integrator from the previous call gives the
+ * same result as integrating from epoch, forwards, backwards and across
+ * epoch
+ */
+TEST( DeepSpaceContextMatchesFreshPropagation )
+{
+    const double times[] = { 0.0, 720.0, 1440.0, 10000.0, 9000.0, 20000.0, -3000.0, 15.5, 43200.0 };
+
+    for ( const Fixtures::Satellite& satellite : { Fixtures::kGeo, Fixtures::kMolniya, Fixtures::kResonant } )
+    {
+        const SGP4::SGP4 sgp4( Tle( satellite.line_one, satellite.line_two ) );
+        SGP4::SGP4::PropagationContext context;
+        for ( const double tsince : times )
+        {
+            CHECK( SamePosition( sgp4.FindPosition( context, tsince ), sgp4.FindPosition( tsince ) ) );
+        }
+        for ( double tsince = 0.0; tsince < 5000.0; tsince += 37.0 )
+        {
+            CHECK( SamePosition( sgp4.FindPosition( context, tsince ), sgp4.FindPosition( tsince ) ) );
+        }
+    }
+}
+
+/*
+ * a context carried to another orbit restarts from epoch, even when the
+ * new propagator lives at the address of the old one
+ */
+TEST( DeepSpaceContextFollowsPropagator )
+{
+    const Tle molniya( Fixtures::kMolniya.line_one, Fixtures::kMolniya.line_two );
+    const Tle resonant( Fixtures::kResonant.line_one, Fixtures::kResonant.line_two );
+
+    SGP4::SGP4 sgp4( molniya );
+    SGP4::SGP4::PropagationContext context;
+    sgp4.FindPosition( context, 9000.0 );
+
+    sgp4 = SGP4::SGP4( resonant );
+    CHECK( SamePosition( sgp4.FindPosition( context, 10000.0 ), SGP4::SGP4( resonant ).FindPosition( 10000.0 ) ) );
+
+    sgp4.SetTle( molniya );
+    CHECK( SamePosition( sgp4.FindPosition( context, 10000.0 ), SGP4::SGP4( molniya ).FindPosition( 10000.0 ) ) );
+
+    /*
+     * a copy shares the elements, so it may continue the checkpoint
+     */
+    const SGP4::SGP4 copy( sgp4 );
+    CHECK( SamePosition( copy.FindPosition( context, 11000.0 ), SGP4::SGP4( molniya ).FindPosition( 11000.0 ) ) );
+}
+
+TEST( FindPositionsMatchesFindPosition )
+{
+    /*
+     * a count that leaves a partial group of lanes, times before and
+     * after epoch
+     */
+    std::vector< double > times;
+    for ( int i = 0; i < 1001; i++ )
+    {
+        times.push_back( -720.0 + i * 2.371 );
+    }
+
+    std::vector< Vector > positions( times.size() );
+    std::vector< Vector > velocities( times.size() );
+    for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+    {
+        const SGP4::SGP4 sgp4( Tle( satellite.line_one, satellite.line_two ) );
+        sgp4.FindPositions( times.data(), times.size(), positions.data(), velocities.data() );
+
+        size_t differing = 0;
+        for ( size_t i = 0; i < times.size(); i++ )
+        {
+            const Eci eci = sgp4.FindPosition( times[i] );
+            differing += positions[i] == eci.Position() && velocities[i] == eci.Velocity() ? 0 : 1;
+        }
+        CHECK( differing == 0 );
+    }
+}
+
+TEST( FindPositionsThrowsAtFirstFailure )
+{
+    /*
+     * the leo fixture with a drag term a thousand times larger, so it
+     * decays within days
+     */
+    std::string line_one( Fixtures::kLeo.line_one );
+    line_one.replace( 53, 8, " 35940-1" );
+    const SGP4::SGP4 sgp4( Tle( line_one, Fixtures::kLeo.line_two ) );
+
+    std::vector< double > times;
+    size_t first_failure = 0;
+    for ( double t = 0.0; first_failure == 0; t += 10.0 )
+    {
+        try
+        {
+            sgp4.FindPosition( t );
+        }
+        catch ( DecayedException& )
+        {
+            first_failure = times.size();
+        }
+        times.push_back( t );
+    }
+    times.push_back( times.back() + 10.0 );
+
+    std::vector< Vector > positions( times.size() );
+    std::vector< Vector > velocities( times.size() );
+    bool thrown = false;
+    try
+    {
+        sgp4.FindPositions( times.data(), times.size(), positions.data(), velocities.data() );
+    }
+    catch ( DecayedException& )
+    {
+        thrown = true;
+    }
+    CHECK( thrown );
+    CHECK( first_failure > 0 );
+    for ( size_t i = 0; i < first_failure; i++ )
+    {
+        CHECK( positions[i] == sgp4.FindPosition( times[i] ).Position() );
+    }
+}
+
+TEST( SatelliteBatchMatchesFindPosition )
+{
+    std::vector< OrbitalElements > elements;
+    for ( int copy = 0; copy < 9; copy++ )
+    {
+        for ( const Fixtures::Satellite& satellite : Fixtures::kSatellites )
+        {
+            elements.push_back( OrbitalElements( Tle( satellite.line_one, satellite.line_two ) ) );
+        }
+    }
+
+    const SatelliteBatch batch( elements );
+    std::vector< Vector > positions( batch.Size() );
+    std::vector< Vector > velocities( batch.Size() );
+    std::vector< SatelliteBatch::Status > statuses( batch.Size() );
+    const DateTime dt = elements[0].Epoch().AddMinutes( 1234.5 );
+    batch.FindPositions( dt, positions.data(), velocities.data(), statuses.data() );
+
+    for ( size_t i = 0; i < elements.size(); i++ )
+    {
+        const Eci eci = SGP4::SGP4( elements[i] ).FindPosition( dt );
+        CHECK( statuses[i] == SatelliteBatch::Status::Ok );
+        CHECK( positions[i] == eci.Position() );
+        CHECK( velocities[i] == eci.Velocity() );
+    }
+}
+
+TEST( SnapshotRoundTrip )
+{
+    const std::vector< TleRecord > records = Records();
+
+    for ( const bool with_constants : { false, true } )
+    {
+        TleSnapshot::Write( kSnapshotFile, records, with_constants );
+        const TleSnapshot snapshot( kSnapshotFile );
+
+        CHECK( snapshot.Size() == records.size() );
+        CHECK( snapshot.HasConstants() == with_constants );
+        for ( size_t i = 0; i < records.size() && i < snapshot.Size(); i++ )
+        {
+            CHECK( std::strcmp( snapshot.Record( i ).name, records[i].name ) == 0 );
+            CHECK( snapshot.Record( i ).norad_number == records[i].norad_number );
+            CHECK( snapshot.Record( i ).epoch == records[i].epoch );
+            CHECK( snapshot.Record( i ).mean_motion == records[i].mean_motion );
+
+            const SGP4::SGP4 fresh( ( OrbitalElements( records[i] ) ) );
+            CHECK( SamePosition( snapshot.Propagator( i ).FindPosition( 4321.0 ),
+                                 fresh.FindPosition( 4321.0 ) ) );
+        }
+    }
+
+    std::remove( kSnapshotFile );
+}
+
+TEST( SnapshotRejectsCorruptFiles )
+{
+    TleSnapshot::Write( kSnapshotFile, Records(), true );
+    const std::string good = ReadFile( kSnapshotFile );
+    CHECK( !Rejected( good ) );
+
+    std::string bad_magic = good;
+    bad_magic[0] = 'X';
+    CHECK( Rejected( bad_magic ) );
+
+    CHECK( Rejected( good.substr( 0, good.size() - 1 ) ) );
+    CHECK( Rejected( good.substr( 0, 16 ) ) );
+    CHECK( Rejected( std::string() ) );
+
+    /*
+     * counts and offsets whose end wraps around to inside the file
+     */
+    const uint64_t max = std::numeric_limits< uint64_t >::max();
+    CHECK( Rejected( WithField( good, kCountField, max ) ) );
+    CHECK( Rejected( WithField( good, kRecordsOffsetField, max - 63 ) ) );
+    CHECK( Rejected( WithField( good, kStatesOffsetField, max - 63 ) ) );
+
+    /*
+     * arrays inside the header, misaligned or overlapping each other
+     */
+    const uint64_t records_offset = Field( good, kRecordsOffsetField );
+    const uint64_t states_offset = Field( good, kStatesOffsetField );
+    CHECK( Rejected( WithField( good, kRecordsOffsetField, 0 ) ) );
+    CHECK( Rejected( WithField( good, kRecordsOffsetField, records_offset + 1 ) ) );
+    CHECK( Rejected( WithField( good, kStatesOffsetField, records_offset ) ) );
+
+    /*
+     * stored flags that are not a bool
+     */
+    const size_t first_state = static_cast< size_t >( states_offset );
+    const size_t state_size = ( good.size() - first_state ) / Records().size();
+    std::string bad_flags = good;
+    bad_flags.replace( first_state, state_size, state_size, '\x02' );
+    CHECK( Rejected( bad_flags ) );
+
+    /*
+     * names without their terminator
+     */
+    const size_t first_record = static_cast< size_t >( records_offset );
+    std::string bad_name = good;
+    bad_name.replace( first_record + offsetof( TleRecord, name ),
+                      sizeof( TleRecord::name ), sizeof( TleRecord::name ), 'X' );
+    CHECK( Rejected( bad_name ) );
+
+    std::string bad_designator = good;
+    bad_designator.replace( first_record + sizeof( TleRecord )
+                            + offsetof( TleRecord, int_designator ),
+                            sizeof( TleRecord::int_designator ),
+                            sizeof( TleRecord::int_designator ), 'X' );
+    CHECK( Rejected( bad_designator ) );
+
+    std::remove( kSnapshotFile );
+}
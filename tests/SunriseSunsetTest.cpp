@@ -0,0 +1,377 @@
+#include "Test.h"
+
+#include <SGP4/CoordGeodetic.h>
+#include <SGP4/CoordTopocentric.h>
+#include <SGP4/DateTime.h>
+#include <SGP4/Observer.h>
+#include <SGP4/SolarPosition.h>
+#include <SGP4/Util.h>
+#include "SunriseSunsetCache.h"
+#include "SunriseSunsetTime.h"
+
+#include <vector>
+
+using namespace SGP4;
+
+namespace {
+/*
+ * the difference of two event times in seconds, zero when both are unset
+ */
+double Seconds( const DateTime& a, const DateTime& b )
+{
+    return ( a - b ).TotalSeconds();
+}
+
+/*
+ * 105 sites from 84 degrees south to 84 north, all around the globe
+ */
+std::vector< CoordGeodetic > Sites()
+{
+    std::vector< CoordGeodetic > sites;
+    for ( double latitude = -84.0; latitude <= 84.0; latitude += 12.0 )
+    {
+        for ( double longitude = -171.0; longitude < 180.0; longitude += 51.0 )
+        {
+            sites.push_back( CoordGeodetic( latitude, longitude, 0.1 ) );
+        }
+    }
+    return sites;
+}
+}
+
+/*
+ * the hour angle fast path finds the same events as the scan, across
+ * latitudes up to the polar circles and beyond, and across the year
+ */
+TEST( HourAngleMatchesScan )
+{
+    for ( double latitude = -86.0; latitude <= 86.0; latitude += 6.3 )
+    {
+        for ( double longitude = -180.0; longitude < 180.0; longitude += 47.0 )
+        {
+            const Observer observer( latitude, longitude, 0.1 );
+            for ( int day = 0; day < 366; day += 23 )
+            {
+                const DateTime date = DateTime( 2024, 1, 1, 0, 0, 0 ).AddDays( day );
+                const SunriseSunsetResult scan = getSunriseSunset( date, observer, SunriseSunsetMethod::Scan );
+                const SunriseSunsetResult hour_angle = getSunriseSunset( date, observer,
+                        SunriseSunsetMethod::HourAngle );
+                CHECK( scan.status == hour_angle.status );
+                CHECK_NEAR( Seconds( scan.sunrise, hour_angle.sunrise ), 0.0, 0.0015 );
+                CHECK_NEAR( Seconds( scan.sunset, hour_angle.sunset ), 0.0, 0.0015 );
+            }
+        }
+    }
+}
+
+/*
+ * just inside the arctic circle at the winter solstice the Sun is up for
+ * a quarter of an hour, less than a scan step, and every search finds the
+ * same sunrise and sunset as a five second scan
+ */
+TEST( ShortDayBetweenScanSamples )
+{
+    const DateTime date( 2024, 12, 21, 0, 0, 0 );
+    for ( double latitude = 66.547; latitude <= 66.5515; latitude += 0.001 )
+    {
+        const Observer observer( latitude, 0.0, 0.0 );
+        DateTime sunrise;
+        DateTime sunset;
+        bool above = false;
+        for ( int64_t seconds = 0; seconds < 86400; seconds += 5 )
+        {
+            const DateTime dt = date.AddTicks( seconds * TicksPerSecond );
+            const bool now_above = observer.GetLookAngle( SolarPosition().FindPosition( dt ) ).elevation > 0.0;
+            if ( now_above && !above )
+            {
+                sunrise = dt;
+            }
+            if ( !now_above && above )
+            {
+                sunset = dt;
+            }
+            above = now_above;
+        }
+        CHECK( sunrise != DateTime() && sunset != DateTime() );
+
+        const SunriseSunsetResult scan = getSunriseSunset( date, observer, SunriseSunsetMethod::Scan );
+        const SunriseSunsetResult hour_angle = getSunriseSunset( date, observer, SunriseSunsetMethod::HourAngle );
+        const std::vector< SolarEvent > events = getSolarEvents( date, observer, std::vector< double >( 1, 0.0 ) );
+        const CoordGeodetic site( latitude, 0.0, 0.0 );
+        SunriseSunsetResult batch;
+        getSunriseAndSunsetTimeBatch( date, &site, 1, &batch.sunrise, &batch.sunset, &batch.status );
+
+        const SunriseSunsetResult found[] = {
+            scan, hour_angle, batch,
+            SunriseSunsetResult{ events[0].rising, events[0].setting, events[0].status } };
+        for ( const SunriseSunsetResult& result : found )
+        {
+            CHECK( result.status == SunriseSunsetStatus::Normal );
+            CHECK_NEAR( Seconds( sunrise, result.sunrise ), 2.5, 2.5 );
+            CHECK_NEAR( Seconds( sunset, result.sunset ), 2.5, 2.5 );
+        }
+    }
+}
+
+TEST( UtcLocalDayMatchesUtcDate )
+{
+    const Observer observer( 35.0, -150.0, 0.0 );
+    for ( int day = 0; day < 366; day += 31 )
+    {
+        const DateTime date = DateTime( 2024, 1, 1, 0, 0, 0 ).AddDays( day );
+        const SunriseSunsetResult utc = getSunriseSunset( date, observer );
+        const SunriseSunsetResult local = getSunriseSunset( getLocalDay( date, TimeSpan( 0 ) ), observer );
+        CHECK( utc.status == local.status );
+        CHECK( utc.sunrise == local.sunrise );
+        CHECK( utc.sunset == local.sunset );
+    }
+
+    /*
+     * ten hours behind UTC the local day holds the sunset that falls on
+     * the next UTC date
+     */
+    const DateTime date( 2024, 6, 1, 0, 0, 0 );
+    const SunriseSunsetResult local = getSunriseSunset( getLocalDay( date, TimeSpan( -10, 0, 0 ) ), observer );
+    CHECK( local.status == SunriseSunsetStatus::Normal );
+    CHECK( local.sunrise < local.sunset );
+    CHECK( local.sunset.Day() == 2 );
+}
+
+TEST( CacheCountsHitsAndMisses )
+{
+    SunriseSunsetCacheOptions options;
+    options.capacity = 8;
+    options.shards = 2;
+    SunriseSunsetCache cache( options );
+    const DateTime date( 2024, 3, 5, 17, 0, 0 );
+
+    /*
+     * the first lookup misses, a nearby location in the same cell hits
+     */
+    const SunriseSunsetResult first = cache.get( date, Observer( 51.5, -0.1, 0.0 ) );
+    const SunriseSunsetResult second = cache.get( date, Observer( 51.501, -0.101, 0.01 ) );
+    CHECK( first.sunrise == second.sunrise && first.sunset == second.sunset );
+    CHECK( cache.stats().hits == 1 );
+    CHECK( cache.stats().misses == 1 );
+    CHECK( cache.stats().size == 1 );
+
+    /*
+     * results are those of the centre of the cell
+     */
+    const SunriseSunsetResult direct = getSunriseSunset( DateTime( 2024, 3, 5, 0, 0, 0 ),
+            Observer( 51.5, -0.1, 0.0 ), options.method );
+    CHECK( first.sunrise == direct.sunrise && first.sunset == direct.sunset );
+
+    /*
+     * another threshold is another key
+     */
+    cache.get( date, Observer( 51.5, -0.1, 0.0 ), civilTwilightElevation );
+    CHECK( cache.stats().misses == 2 );
+
+    /*
+     * the size stays within the capacity
+     */
+    for ( int day = 0; day < 50; day++ )
+    {
+        cache.get( date.AddDays( day ), Observer( 10.0, 10.0, 0.0 ) );
+    }
+    CHECK( cache.stats().size <= options.capacity );
+    CHECK( cache.stats().misses == 52 );
+
+    cache.clear();
+    CHECK( cache.stats().hits == 0 && cache.stats().misses == 0 && cache.stats().size == 0 );
+}
+
+TEST( CacheHoldsExactlyItsCapacity )
+{
+    const DateTime date( 2024, 3, 5, 17, 0, 0 );
+    const size_t capacities[] = { 3, 10, 17 };
+    for ( const size_t capacity : capacities )
+    {
+        SunriseSunsetCacheOptions options;
+        options.capacity = capacity;
+        options.shards = 4;
+        SunriseSunsetCache cache( options );
+        for ( int day = 0; day < 200; day++ )
+        {
+            cache.get( date.AddDays( day ), Observer( 10.0, 10.0, 0.0 ) );
+        }
+        CHECK( cache.stats().size == capacity );
+    }
+}
+
+TEST( CacheKeysTheAntimeridianOnce )
+{
+    SunriseSunsetCache cache;
+    const DateTime date( 2024, 3, 5, 17, 0, 0 );
+
+    /*
+     * both sides of the antimeridian fall in the cell centred on it
+     */
+    const SunriseSunsetResult east = cache.get( date, Observer( 10.0, 180.0, 0.0 ) );
+    const SunriseSunsetResult near_east = cache.get( date, Observer( 10.0, 179.996, 0.0 ) );
+    const SunriseSunsetResult west = cache.get( date, Observer( 10.0, -180.0, 0.0 ) );
+    const SunriseSunsetResult near_west = cache.get( date, Observer( 10.0, -179.996, 0.0 ) );
+    CHECK( cache.stats().misses == 1 );
+    CHECK( cache.stats().hits == 3 );
+    CHECK( east.sunrise == west.sunrise && east.sunset == west.sunset );
+    CHECK( near_east.sunrise == near_west.sunrise && near_east.sunset == near_west.sunset );
+}
+
+/*
+ * the calendar, seeded from the days before, finds the events of
+ * searching each day on its own, every day of a year at every site
+ */
+TEST( CalendarMatchesEachDay )
+{
+    const DateTime first( 2024, 1, 1, 0, 0, 0 );
+    const DateTime last( 2024, 12, 31, 0, 0, 0 );
+    for ( const CoordGeodetic& site : Sites() )
+    {
+        const Observer observer( site );
+        const std::vector< SunriseSunsetResult > calendar = getSunriseSunsetCalendar( observer, first, last );
+        CHECK( calendar.size() == 366 );
+        for ( size_t day = 0; day < calendar.size(); day++ )
+        {
+            const SunriseSunsetResult each = getSunriseSunset( first.AddDays( static_cast< double >( day ) ),
+                    observer );
+            CHECK( calendar[day].status == each.status );
+            CHECK_NEAR( Seconds( calendar[day].sunrise, each.sunrise ), 0.0, 0.0015 );
+            CHECK_NEAR( Seconds( calendar[day].sunset, each.sunset ), 0.0, 0.0015 );
+        }
+    }
+}
+
+/*
+ * the batch, sharing the Sun's track between sites, finds the events of
+ * searching each site on its own, every day of a year
+ */
+TEST( BatchMatchesEachSite )
+{
+    const DateTime first( 2024, 1, 1, 0, 0, 0 );
+    const std::vector< CoordGeodetic > sites = Sites();
+    std::vector< DateTime > sunrises( sites.size() );
+    std::vector< DateTime > sunsets( sites.size() );
+    std::vector< SunriseSunsetStatus > statuses( sites.size() );
+    for ( int day = 0; day < 366; day++ )
+    {
+        const DateTime date = first.AddDays( day );
+        getSunriseAndSunsetTimeBatch( date, sites.data(), sites.size(),
+                sunrises.data(), sunsets.data(), statuses.data() );
+        for ( size_t i = 0; i < sites.size(); i++ )
+        {
+            const SunriseSunsetResult each = getSunriseSunset( date, Observer( sites[i] ) );
+            CHECK( statuses[i] == each.status );
+            CHECK_NEAR( Seconds( sunrises[i], each.sunrise ), 0.0, 0.0015 );
+            CHECK_NEAR( Seconds( sunsets[i], each.sunset ), 0.0, 0.0015 );
+        }
+    }
+}
+
+/*
+ * getSolarDay against a minute by minute scan of the Sun's elevation. Its
+ * sunrise is the crossing of sunriseElevation that getSolarEvents finds,
+ * its culminations are the highest and lowest turning minutes, or the
+ * ends of the day when none is inside it, to within a minute, and its day
+ * length is the time of the minutes above sunriseElevation to a minute
+ */
+TEST( SolarDayMatchesScan )
+{
+    const DateTime first( 2024, 1, 1, 0, 0, 0 );
+    for ( const CoordGeodetic& site : Sites() )
+    {
+        const Observer observer( site );
+        for ( int day = 0; day < 366; day += 30 )
+        {
+            const DateTime date = first.AddDays( day );
+            const SolarDay solar_day = getSolarDay( date, observer );
+
+            const SolarEvent sunrise = getSolarEvents( date, observer,
+                    std::vector< double >( 1, sunriseElevation ) ).front();
+            CHECK( solar_day.sunrise.status == sunrise.status );
+            CHECK( solar_day.sunrise.rising == sunrise.rising );
+            CHECK( solar_day.sunrise.setting == sunrise.setting );
+
+            std::vector< double > elevations;
+            for ( int minute = 0; minute <= 1440; minute++ )
+            {
+                elevations.push_back( Util::RadiansToDegrees( observer.GetLookAngle(
+                                SolarPosition().FindPosition( date.AddMinutes( minute ) ) ).elevation ) );
+            }
+
+            size_t highest = 0;
+            size_t lowest = 0;
+            int minutes_up = 0;
+            for ( size_t i = 1; i < 1440; i++ )
+            {
+                const double e = elevations[i];
+                if ( e >= elevations[i - 1] && e >= elevations[i + 1]
+                        && ( highest == 0 || e > elevations[highest] ) )
+                {
+                    highest = i;
+                }
+                if ( e <= elevations[i - 1] && e <= elevations[i + 1]
+                        && ( lowest == 0 || e < elevations[lowest] ) )
+                {
+                    lowest = i;
+                }
+            }
+            if ( highest == 0 )
+            {
+                highest = elevations[0] >= elevations[1440] ? 0 : 1440;
+            }
+            if ( lowest == 0 )
+            {
+                lowest = elevations[0] <= elevations[1440] ? 0 : 1440;
+            }
+            for ( size_t i = 0; i < 1440; i++ )
+            {
+                minutes_up += elevations[i] > sunriseElevation ? 1 : 0;
+            }
+
+            CHECK( solar_day.transitElevation >= elevations[highest] - 1e-6 );
+            CHECK_NEAR( solar_day.transitElevation, elevations[highest], 0.05 );
+            CHECK_NEAR( Seconds( solar_day.transit, date.AddMinutes( static_cast< double >( highest ) ) ),
+                    0.0, 60.0 );
+            CHECK( solar_day.antiTransitElevation <= elevations[lowest] + 1e-6 );
+            CHECK_NEAR( solar_day.antiTransitElevation, elevations[lowest], 0.05 );
+            CHECK_NEAR( Seconds( solar_day.antiTransit, date.AddMinutes( static_cast< double >( lowest ) ) ),
+                    0.0, 60.0 );
+            CHECK_NEAR( solar_day.dayLength.TotalSeconds(), minutes_up * 60.0, 120.0 );
+        }
+    }
+}
+
+/*
+ * days classified from the Sun's declination before any search get the
+ * status a scan of the day gives, every day of a year from the polar
+ * circles to the poles
+ */
+TEST( PolarClassificationMatchesScan )
+{
+    const DateTime first( 2024, 1, 1, 0, 0, 0 );
+    size_t polar = 0;
+    for ( double latitude = 62.5; latitude <= 90.0; latitude += 2.5 )
+    {
+        for ( const double sign : { -1.0, 1.0 } )
+        {
+            const Observer observer( sign * latitude, sign * 97.0, 0.0 );
+            for ( int day = 0; day < 366; day++ )
+            {
+                const DateTime date = first.AddDays( day );
+                const SolarEvent scan = getSolarEvents( date, observer, std::vector< double >( 1, 0.0 ) ).front();
+                const SunriseSunsetMethod methods[] = { SunriseSunsetMethod::Scan, SunriseSunsetMethod::HourAngle };
+                for ( const SunriseSunsetMethod method : methods )
+                {
+                    const SunriseSunsetResult result = getSunriseSunset( date, observer, method );
+                    CHECK( result.status == scan.status );
+                    CHECK_NEAR( Seconds( result.sunrise, scan.rising ), 0.0, 0.0015 );
+                    CHECK_NEAR( Seconds( result.sunset, scan.setting ), 0.0, 0.0015 );
+                }
+                polar += scan.status == SunriseSunsetStatus::PolarDay
+                    || scan.status == SunriseSunsetStatus::PolarNight ? 1 : 0;
+            }
+        }
+    }
+    CHECK( polar > 2000 );
+}
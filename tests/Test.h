@@ -0,0 +1,85 @@
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A minimal test registry for sgp4_tests.
+ *
+ * TEST defines a function that is registered before main runs. CHECK and
+ * CHECK_NEAR record a failure with its location and carry on, so one run
+ * reports every failing check.
+ */
+namespace Test {
+
+typedef void ( *Function )();
+
+struct Case
+{
+    const char* name;
+    Function function;
+};
+
+inline std::vector< Case >& Cases()
+{
+    static std::vector< Case > cases;
+    return cases;
+}
+
+inline std::vector< std::string >& Failures()
+{
+    static std::vector< std::string > failures;
+    return failures;
+}
+
+struct Registrar
+{
+    Registrar( const char* name, const Function function )
+    {
+        Case test_case = { name, function };
+        Cases().push_back( test_case );
+    }
+};
+
+inline void Fail( const char* file, const int line, const std::string& message )
+{
+    std::ostringstream ss;
+    ss << file << ":" << line << ": " << message;
+    Failures().push_back( ss.str() );
+}
+
+} //namespace Test
+
+#define TEST( name ) \
+    static void name(); \
+    static const Test::Registrar name##_registrar( #name, name ); \
+    static void name()
+
+#define CHECK( condition ) \
+    do \
+    { \
+        if ( !( condition ) ) \
+        { \
+            Test::Fail( __FILE__, __LINE__, "CHECK( " #condition " )" ); \
+        } \
+    } while ( 0 )
+
+#define CHECK_NEAR( actual, expected, tolerance ) \
+    do \
+    { \
+        const double check_actual = ( actual ); \
+        const double check_expected = ( expected ); \
+        if ( !( std::fabs( check_actual - check_expected ) <= ( tolerance ) ) ) \
+        { \
+            std::ostringstream check_ss; \
+            check_ss.precision( 17 ); \
+            check_ss << "CHECK_NEAR( " #actual ", " #expected " ): " \
+                << check_actual << " vs " << check_expected; \
+            Test::Fail( __FILE__, __LINE__, check_ss.str() ); \
+        } \
+    } while ( 0 )
+
+#endif
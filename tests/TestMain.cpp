@@ -0,0 +1,55 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+/*
+ * runs every test, or those whose name contains the first argument
+ */
+int main( int argc, char* argv[] )
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+    int run = 0;
+    int failed = 0;
+
+    for ( const Test::Case& test_case : Test::Cases() )
+    {
+        if ( std::strstr( test_case.name, filter ) == nullptr )
+        {
+            continue;
+        }
+
+        const size_t failures = Test::Failures().size();
+        try
+        {
+            test_case.function();
+        }
+        catch ( const std::exception& e )
+        {
+            Test::Fail( test_case.name, 0, std::string( "unexpected exception: " ) + e.what() );
+        }
+        catch ( ... )
+        {
+            Test::Fail( test_case.name, 0, "unexpected exception" );
+        }
+
+        run++;
+        if ( Test::Failures().size() != failures )
+        {
+            failed++;
+            std::printf( "FAIL %s\n", test_case.name );
+            for ( size_t i = failures; i < Test::Failures().size(); i++ )
+            {
+                std::printf( "    %s\n", Test::Failures()[i].c_str() );
+            }
+        }
+        else
+        {
+            std::printf( "ok   %s\n", test_case.name );
+        }
+    }
+
+    std::printf( "%d tests, %d failed\n", run, failed );
+    return failed == 0 && run > 0 ? 0 : 1;
+}